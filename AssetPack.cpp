@@ -0,0 +1,167 @@
+#include "AssetPack.h"
+#include <SFML/Graphics.hpp>
+#include <SFML/Audio.hpp>
+#include <fstream>
+#include <vector>
+#include <cstring>
+#include <cctype>
+#include <iostream>
+
+using namespace sf;
+
+static const char PACK_MAGIC[4] = { 'A', 'P', 'A', 'K' };
+static const uint32_t PACK_VERSION = 1;
+
+struct PackHeader {
+	char magic[4];
+	uint32_t version;
+	uint32_t count; //entries follow the header
+	uint32_t reserved;
+};
+
+static_assert(sizeof(PackHeader) == 16, "pack header layout");
+static_assert(sizeof(AssetEntry) == 96, "pack entry layout");
+
+static uint64_t Align(const uint64_t& x) {
+	return (x + 15) / 16 * 16;
+}
+
+bool AssetPack::Open(const std::string& path) {
+	index.clear();
+	if (!file.Open(path)) {
+		return false;
+	}
+	const PackHeader* header = reinterpret_cast<const PackHeader*>(file.Data());
+	if (file.Size() < sizeof(PackHeader) || memcmp(header->magic, PACK_MAGIC, 4) != 0 || header->version != PACK_VERSION ||
+		(file.Size() - sizeof(PackHeader)) / sizeof(AssetEntry) < header->count) {
+		std::cerr << path << " is damaged or of another version, assets are loaded from files\n";
+		file.Close();
+		return false;
+	}
+	const AssetEntry* entries = reinterpret_cast<const AssetEntry*>(file.Data() + sizeof(PackHeader));
+	for (uint32_t i = 0; i < header->count; ++i) {
+		const AssetEntry& e = entries[i];
+		bool fits = e.offset <= file.Size() && e.size <= file.Size() - e.offset;
+		if (e.type == uint32_t(AssetType::IMAGE)) {
+			fits = fits && e.size == uint64_t(e.a) * e.b * 4;
+		}
+		else if (e.type == uint32_t(AssetType::SOUND)) {
+			fits = fits && e.a > 0 && e.size % (2 * e.a) == 0;
+		}
+		if (!fits) {
+			std::cerr << path << " is damaged, assets are loaded from files\n";
+			index.clear();
+			file.Close();
+			return false;
+		}
+		index[std::string(e.name, strnlen(e.name, sizeof(e.name)))] = &e;
+	}
+	return true;
+}
+
+bool AssetPack::IsOpen() const {
+	return file.IsOpen();
+}
+
+const AssetEntry* AssetPack::Find(const std::string& path, const AssetType& type) const {
+	auto it = index.find(Key(path));
+	if (it == index.end() || it->second->type != uint32_t(type)) {
+		return nullptr;
+	}
+	return it->second;
+}
+
+const void* AssetPack::Data(const AssetEntry& entry) const {
+	return file.Data() + entry.offset;
+}
+
+std::string AssetPack::Key(const std::string& path) {
+	std::string key = path;
+	for (char& c : key) {
+		c = c == '\\' ? '/' : char(tolower((unsigned char)c)); //paths are case-insensitive on Windows
+	}
+	return key;
+}
+
+bool AssetPack::Write(const std::string& path) {
+	struct Item {
+		AssetEntry entry;
+		std::vector<char> data;
+	};
+	std::vector<Item> items;
+	auto add = [&items](const std::string& name, const AssetType& type, const uint32_t& a, const uint32_t& b,
+		const void* data, const size_t& size) {
+		std::string key = Key(name);
+		if (key.size() >= sizeof(AssetEntry::name)) {
+			std::cerr << name << ": name is too long for the pack, skipped\n";
+			return;
+		}
+		Item item;
+		memset(&item.entry, 0, sizeof(AssetEntry));
+		memcpy(item.entry.name, key.data(), key.size());
+		item.entry.type = uint32_t(type);
+		item.entry.a = a;
+		item.entry.b = b;
+		item.entry.size = size;
+		item.data.assign(static_cast<const char*>(data), static_cast<const char*>(data) + size);
+		items.push_back(std::move(item));
+	};
+
+	for (const std::string& f : ListFiles("images")) {
+		Image image;
+		if (image.loadFromFile("images/" + f)) {
+			add("images/" + f, AssetType::IMAGE, image.getSize().x, image.getSize().y,
+				image.getPixelsPtr(), size_t(image.getSize().x) * image.getSize().y * 4);
+		}
+	}
+	for (const std::string& f : ListFiles("sounds")) {
+		SoundBuffer buffer;
+		if (buffer.loadFromFile("sounds/" + f)) {
+			add("sounds/" + f, AssetType::SOUND, buffer.getChannelCount(), buffer.getSampleRate(),
+				buffer.getSamples(), size_t(buffer.getSampleCount()) * sizeof(Int16));
+		}
+	}
+	for (const std::string& f : ListFiles("fonts")) { //fonts are parsed lazily by FreeType, kept as they are
+		std::ifstream in("fonts/" + f, std::ios::binary);
+		std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+		if (!bytes.empty()) {
+			add("fonts/" + f, AssetType::FONT, 0, 0, bytes.data(), bytes.size());
+		}
+	}
+
+	PackHeader header;
+	memcpy(header.magic, PACK_MAGIC, 4);
+	header.version = PACK_VERSION;
+	header.count = uint32_t(items.size());
+	header.reserved = 0;
+	uint64_t offset = Align(sizeof(PackHeader) + items.size() * sizeof(AssetEntry));
+	for (Item& item : items) {
+		item.entry.offset = offset;
+		offset = Align(offset + item.entry.size);
+	}
+
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	for (const Item& item : items) {
+		out.write(reinterpret_cast<const char*>(&item.entry), sizeof(AssetEntry));
+	}
+	static const char zeros[16] = {};
+	for (const Item& item : items) {
+		out.write(zeros, std::streamsize(item.entry.offset - uint64_t(out.tellp())));
+		out.write(item.data.data(), std::streamsize(item.data.size()));
+	}
+	out.write(zeros, std::streamsize(offset - uint64_t(out.tellp())));
+	if (!out) {
+		std::cerr << "can't write " << path << '\n';
+		return false;
+	}
+	std::cout << "packed " << items.size() << " assets into " << path << " (" << offset / 1024 << " KB)\n";
+	return true;
+}
+
+AssetPack& Assets() {
+	static AssetPack pack;
+	static bool opened = pack.Open("assets.pack"); //once, on the first use
+	(void)opened;
+	return pack;
+}
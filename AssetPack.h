@@ -0,0 +1,37 @@
+#pragma once
+#include <string>
+#include <map>
+#include <cstdint>
+#include "MappedFile.h"
+
+enum class AssetType : uint32_t { IMAGE, SOUND, FONT };
+
+//One record of the pack's index. The data of every asset is 16-byte aligned.
+struct AssetEntry {
+	char name[64]; //lower case path, "images/button.png"
+	uint32_t type; //AssetType
+	uint32_t a, b; //IMAGE: width, height (RGBA8 pixels); SOUND: channels, sample rate (Int16 samples)
+	uint32_t reserved;
+	uint64_t offset; //from the start of the file
+	uint64_t size; //bytes
+};
+
+//All images, sounds and fonts of the game decoded ahead of time into one file ("--pack").
+//At runtime the file is mapped once and assets are created straight from the mapped
+//pixels and samples: no PNG/WAV decoding and no file opens. The pack doesn't notice
+//changed assets, so it has to be rebuilt after editing images/ or sounds/.
+class AssetPack {
+private:
+	MappedFile file;
+	std::map<std::string, const AssetEntry*> index;
+public:
+	bool Open(const std::string& path); //false if missing or damaged, the pack stays empty then
+	bool IsOpen() const;
+	const AssetEntry* Find(const std::string& path, const AssetType& type) const; //nullptr if not packed
+	const void* Data(const AssetEntry& entry) const;
+
+	static std::string Key(const std::string& path); //how the pack names a path
+	static bool Write(const std::string& path); //packs images/, sounds/ and fonts/
+};
+
+AssetPack& Assets(); //"assets.pack" next to the game, empty if there is none
@@ -3,8 +3,7 @@
 
 class Button : public Object {
 private:
-	Font font;
-	Text text;
+	SdfText text;
 	String name;
 	Color sel_color = Color(0x0000f0ff);
 	Color not_sel_color = Color(0x0000f080);
@@ -12,6 +11,7 @@ public:
 	Button(const Button& b);
 	Button(const String& _name, const Vector2f& position);
 	void Draw(RenderWindow& window) const;
+	void DrawLabels(TextBatch& batch) const;
 	void SetColor(const Color& c);
 	void SetSelected(bool selected);
 };
\ No newline at end of file
@@ -35,77 +35,7 @@ void RigidBody::CollisionModelDraw(RenderWindow& window) {
 
 
 void RigidBody::CollisionDetection(const Surface& s) {
-	
-	long mid_iter = s.Get_iter_0() + 2 * GetCenterPosition().x / s.Get_spacing();
-	long start = mid_iter - (height + width) /(2 * s.Get_spacing());
-	long end = mid_iter + (height + width) / (2 * s.Get_spacing());
-
-	if (start - (height + width) / (2 * s.Get_spacing()) <= 0 || end + (height + width) / (2 * s.Get_spacing()) >= s.Get_VertexCount()) { start = end = mid_iter = 0; return; }
-
-	std::vector<Point> polygon_vertex;
-
-	for (Point i : collision_vertex) {
-		float fb;
-		float x = GetWidth() * i.x;
-		float y = GetHeight() * i.y;
-		if (x >= 0 && y != 0) { fb = atan(y / x); }
-		else if (x < 0) { fb = atan(y / x) - PI; }
-		else { fb = 0; }
-		float diag = sqrt(pow(GetWidth() * i.x, 2) + pow(GetHeight() * i.y, 2));
-
-		polygon_vertex.push_back(Point(
-			GetPosition().x + cos(RAD * GetAngle() + fb) * diag,
-			GetPosition().y + sin(RAD * GetAngle() + fb) * diag)
-		);
-	}
-
-	polygon collision_polygon(polygon_vertex);
-
-	int step = 2;
-	static bool first_collision = false;
-	bool collision_detected = false;
-
-	for (Point i : polygon_vertex) {
-
-		for (int ii = 0; ii < polygon_vertex.size(); ++ii) {
-			int it_point = (s.Get_iter_0() / 2) * 2 + 2 * polygon_vertex[ii].x / s.Get_spacing();
-			for(int small_step = -4; small_step < 3; ++small_step){
-
-				Line surface_line(Point(s.GetVertex(it_point + small_step).position.x, s.GetVertex(it_point + small_step).position.y),
-					Point(s.GetVertex(it_point + step+ small_step).position.x, s.GetVertex(it_point + step+ small_step).position.y));
-
-				if (IntercectionWithSurface(i, surface_line, s)) {
-					CollisionReactionWithSurface(surface_line, first_collision, i, s);
-					
-					first_collision = false;
-					collision_detected = true;
-				}
-				else {
-					NOCollisionReaction();
-				}
-			}
-		}
-	}	
-
-	for (int i = (start / 2) * 2; i < end; i += step) {
-		Point p(s.GetVertex(i).position.x, s.GetVertex(i).position.y);
-		if (collision_polygon.containsPoint(p)) {
-			for (Line ii : collision_polygon.GetLines()) {
-				if (ii.IsOnLine(p)) { CollisionReactionWithSurface(ii, first_collision, p, s); }
-			}
-
-			first_collision = false;
-			collision_detected = true;
-		}
-		else {
-			NOCollisionReaction();
-		}
-	}
-
-	if (collision_detected == false) {
-		first_collision = true;
-	}
-	return;
+	DetectCollision(s, nullptr);
 }
 
 bool RigidBody::IntercectionWithSurface(const Point& p, const Line& surface_line, const Surface& s) const {
@@ -142,6 +72,12 @@ bool RigidBody::IntercectionWithSurface(const Point& p, const Line& surface_line
 
 //////////////////Function overloading is for visualization purposes only///////////////////////////////
 void RigidBody::CollisionDetection(const Surface& s, RenderWindow& window) {
+	DetectCollision(s, &window);
+}
+
+//one search for every mode, so the simulation thread lands where the game loop does;
+//with a window the contacts and the tested lines are drawn on top
+void RigidBody::DetectCollision(const Surface& s, RenderWindow* window) {
 	
 	long mid_iter = s.Get_iter_0() + 2 * GetCenterPosition().x / s.Get_spacing();
 	long start = mid_iter - (height + width) /(2 * s.Get_spacing());
@@ -181,13 +117,15 @@ void RigidBody::CollisionDetection(const Surface& s, RenderWindow& window) {
 				Line surface_line(Point(s.GetVertex(it_point + small_step).position.x, s.GetVertex(it_point + small_step).position.y),
 					Point(s.GetVertex(it_point + step+ small_step).position.x, s.GetVertex(it_point + step+ small_step).position.y));
 
-				if (IntercectionWithSurface(i, surface_line, s, window)) {
+				if (window ? IntercectionWithSurface(i, surface_line, s, *window) : IntercectionWithSurface(i, surface_line, s)) {
 					CollisionReactionWithSurface(surface_line, first_collision, i, s);
 
-					CircleShape Cshape(10.f);
-					Cshape.setFillColor(Color::Red);
-					Cshape.setPosition({ static_cast<float>(i.x) - 5, static_cast<float>(i.y) - 5 });
-					window.draw(Cshape);
+					if (window) {
+						CircleShape Cshape(10.f);
+						Cshape.setFillColor(Color::Red);
+						Cshape.setPosition({ static_cast<float>(i.x) - 5, static_cast<float>(i.y) - 5 });
+						window->draw(Cshape);
+					}
 					 
 					first_collision = false;
 					collision_detected = true;
@@ -206,10 +144,12 @@ void RigidBody::CollisionDetection(const Surface& s, RenderWindow& window) {
 				if (ii.IsOnLine(p)) { CollisionReactionWithSurface(ii, first_collision, p, s); }
 			}
 
-			CircleShape Cshape(10.f);
-			Cshape.setFillColor(Color::Red);
-			Cshape.setPosition({ static_cast<float>(p.x) - 5, static_cast<float>(p.y) - 5 });
-			window.draw(Cshape);
+			if (window) {
+				CircleShape Cshape(10.f);
+				Cshape.setFillColor(Color::Red);
+				Cshape.setPosition({ static_cast<float>(p.x) - 5, static_cast<float>(p.y) - 5 });
+				window->draw(Cshape);
+			}
 
 			first_collision = false;
 			collision_detected = true;
@@ -67,11 +67,11 @@ void Dron::control() {
 	}
 }
 
-void Dron::DrawShip(RenderWindow& window) const {
-	Draw(window);
+void Dron::DrawShip(SpriteBatch& batch) const {
+	DrawSprites(batch);
 	for (const auto& e : engines) {
 		if (e.second.If_on()) {
-			e.second.Draw(window);
+			e.second.DrawSprites(batch);
 		}
 	}
 }
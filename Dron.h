@@ -12,5 +12,6 @@ public:
 	RigidBodyParameters download(sf::Vector2f position);
 	void assembly();
 	void control();
-	virtual void DrawShip(RenderWindow& window) const;
+	using Ship::DrawShip;
+	virtual void DrawShip(SpriteBatch& batch) const;
 };
@@ -2,23 +2,23 @@
 #include "Menu.h"
 
 Engine::Engine() : on(false), relative_position(0, 0), max_thrust_angle(0), thrust_angle(0), thrust(0), engine_vector(0, 0) {
-	buffer.loadFromFile("sounds/" + f_sound);
-	sound.setBuffer(buffer);
+	buffer = LoadSound("sounds/" + f_sound);
+	sound.setBuffer(*buffer);
 	sound.setLoop(1);
 }
 Engine::Engine(const Object& object, const Vector2f& start_rel_pos, const Force& start_force, const float& start_max_thrust_angle)
 	: Object(object.GetFile(), object.GetPosition(), object.GetWidth(), object.GetHeight(), object.GetAngle()),
 	on(false), relative_position(start_rel_pos), force(Force(start_force)),
 	max_thrust_angle(start_max_thrust_angle), thrust_angle(0), thrust(1), engine_vector(start_force.force_vector) {
-	buffer.loadFromFile("sounds/" + f_sound);
-	sound.setBuffer(buffer);
+	buffer = LoadSound("sounds/" + f_sound);
+	sound.setBuffer(*buffer);
 	sound.setLoop(1);
 }
 Engine::Engine(const Engine& e) : Object(e.GetFile(), e.GetPosition(), e.GetWidth(), e.GetHeight(), e.GetAngle()),
 on(e.on), relative_position(e.relative_position), force(e.force), max_thrust_angle(e.max_thrust_angle), thrust_angle(e.thrust_angle),
 thrust(e.thrust), engine_vector(e.force.force_vector) {
-	buffer.loadFromFile("sounds/" + f_sound);
-	sound.setBuffer(buffer);
+	buffer = LoadSound("sounds/" + f_sound);
+	sound.setBuffer(*buffer);
 	sound.setLoop(1);
 }
 
@@ -76,13 +76,7 @@ Engine Engine::operator = (const Engine& e) {
 	exist = e.exist;
 	position = e.position;
 	engine_vector = e.engine_vector;
-	//buffer.loadFromFile("sounds/" + f_sound);
-	//sound.setBuffer(buffer);
-	image.loadFromFile("images/" + file);
-	image.createMaskFromColor(Color(0, 0, 0));
-	texture.loadFromImage(image);
-	sprite.setTexture(texture);
-	sprite.setTextureRect(IntRect(0, 0, width, height));
+	SetImage(true, false);
 	sprite.setPosition(position.x, position.y);
 	sprite.rotate(angle);
 	return e;
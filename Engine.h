@@ -14,7 +14,7 @@ private:
 	float consumption = 0.1;
 
 	String f_sound = "engine.wav";
-	SoundBuffer buffer;
+	std::shared_ptr<const SoundBuffer> buffer;
 	Sound sound;
 public:
 	Engine();
@@ -0,0 +1,78 @@
+#include "Menu.h"
+#include "FrameExporter.h"
+#include <iostream>
+#include <cmath>
+
+//A flight rendered offscreen, "--export". The planet and the ship are fixed and there is
+//no input, so the lander falls with its engines off. The physics steps by the frame
+//time, not by the clock: a frame is as long as drawing it takes, while the encoders
+//finish the previous ones.
+bool ExportFlight(const ExportSettings& settings) {
+	ExportFormat format = settings.path == "-" ||
+		(settings.path.size() > 4 && settings.path.compare(settings.path.size() - 4, 4, ".y4m") == 0) ?
+		ExportFormat::Y4M : ExportFormat::PNG;
+	std::streambuf* out = std::cout.rdbuf();
+	if (settings.path == "-") {
+		std::cout.rdbuf(std::cerr.rdbuf()); //stdout is the video
+	}
+	FrameExporter exporter(format, settings.path, settings.width, settings.height, settings.fps, settings.threads);
+	if (!exporter.IsReady()) {
+		std::cerr << "can't export to " << settings.path << '\n';
+		std::cout.rdbuf(out);
+		return false;
+	}
+
+	std::map<Hole, int> probability = { { Hole::EMPTY_U, 10 }, { Hole::EMPTY_V, 10 }, { Hole::LAKE, 20 },
+		{ Hole::ICE, 10 }, { Hole::METEORITE, 15 } };
+	Surface surface("surface.png", 10, 30, probability, 35, 50, 0, settings.seed, Generator::WALK);
+	Vector2f start_pos = Vector2f(0, surface.YtoX(200) - 500);
+	Space space("Space2.png", start_pos, surface.GetSeed());
+	Lunar_Lander_Mark1 lander(start_pos);
+	lander.AddMainForces(surface.GetGravity());
+	Interface interf(lander.GetHeight(), lander.GetAngle(), 0, 0, 0, 0, 0, "Strat");
+
+	int steps = std::max(1, int(std::ceil(float(SIMULATION_RATE) / settings.fps))); //as fine as on the simulation thread
+	float dt = 1.f / (settings.fps * steps);
+	size_t frames = size_t(settings.seconds * settings.fps);
+	bool crashed = 0;
+	SpriteBatch sprites;
+	RenderTarget& target = exporter.Target();
+	Clock clock;
+	for (size_t f = 0; f < frames; ++f) {
+		for (int i = 0; i < steps; ++i) {
+			lander.UpdateShipPosition(dt);
+			lander.CollisionDetection(surface);
+			lander.DrawFlyStatus(dt);
+			int status = lander.GetFlyStatus();
+			if (!crashed && status >= 2 && status <= 5) { //bad landing
+				crashed = 1;
+				surface.Crater(lander.GetCenterPosition().x, lander.GetWidth(), lander.GetHeight() / 2);
+			}
+			surface.Update(dt);
+		}
+
+		View view = GameView(target, lander.GetCenterPosition());
+		space.Update(view);
+		target.setView(view);
+		target.clear();
+		space.Draw(target);
+		sprites.Clear();
+		lander.DrawShip(sprites);
+		sprites.Draw(target);
+		surface.Draw(target);
+
+		interf.Show(ReadFlight(lander, surface));
+		interf.Draw(target, view, steps * dt);
+
+		exporter.Capture();
+	}
+	bool ok = exporter.Finish();
+	float time = clock.getElapsedTime().asSeconds();
+	std::cout.rdbuf(out);
+	std::cerr << "exported " << exporter.FrameCount() << " frames in " << time << " s ("
+		<< exporter.FrameCount() / std::max(time, 0.001f) << " fps)\n";
+	if (!ok) {
+		std::cerr << "some frames couldn't be written to " << settings.path << '\n';
+	}
+	return ok;
+}
@@ -0,0 +1,135 @@
+#include "FrameExporter.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#endif
+
+FrameExporter::FrameExporter(const ExportFormat& f, const std::string& p, const unsigned int& w,
+	const unsigned int& h, const unsigned int& rate, const unsigned int& threads)
+	: format(f), path(p), width(w & ~1u), height(h & ~1u), fps(rate), //4:2:0 needs even sizes
+	encoders(threads ? threads : std::max(std::thread::hardware_concurrency(), 2u) - 1) {
+	max_in_flight = 2 * int(std::max<size_t>(encoders.Size(), 1));
+	if (width == 0 || height == 0 || !target.create(width, height)) {
+		return;
+	}
+	if (format == ExportFormat::PNG) {
+		ready = MakeDirectory(path);
+	}
+	else {
+		if (path == "-") {
+#ifdef _WIN32
+			_setmode(_fileno(stdout), _O_BINARY);
+#endif
+			stream = stdout;
+		}
+		else {
+			stream = fopen(path.c_str(), "wb");
+		}
+		ready = stream != nullptr &&
+			fprintf(stream, "YUV4MPEG2 W%u H%u F%u:1 Ip A1:1 C420jpeg XCOLORRANGE=FULL\n", width, height, fps) > 0;
+	}
+}
+
+FrameExporter::~FrameExporter() {
+	Finish();
+	if (stream && stream != stdout) {
+		fclose(stream);
+	}
+}
+
+bool FrameExporter::IsReady() const {
+	return ready;
+}
+
+RenderTarget& FrameExporter::Target() {
+	return target;
+}
+
+size_t FrameExporter::FrameCount() const {
+	return captured;
+}
+
+void FrameExporter::Capture() {
+	target.display();
+	auto image = std::make_shared<Image>(target.getTexture().copyToImage()); //the only wait for the GPU
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		changed.wait(lock, [this] { return in_flight < max_in_flight; });
+		++in_flight;
+	}
+	size_t index = captured++;
+	encoders.Push([this, index, image]() { Encode(index, *image); });
+}
+
+void FrameExporter::Encode(const size_t& index, const Image& image) {
+	bool ok = true;
+	if (format == ExportFormat::PNG) {
+		char name[32];
+		snprintf(name, sizeof(name), "/frame_%06u.png", unsigned(index));
+		ok = image.saveToFile(path + name);
+	}
+	std::vector<Uint8> frame;
+	if (format == ExportFormat::Y4M) {
+		frame = Y4mFrame(image);
+	}
+	std::lock_guard<std::mutex> lock(mutex);
+	if (format == ExportFormat::Y4M) {
+		encoded[index] = std::move(frame);
+		for (auto it = encoded.find(written); it != encoded.end(); it = encoded.find(written)) { //next in order
+			ok = ok && fwrite(it->second.data(), 1, it->second.size(), stream) == it->second.size();
+			encoded.erase(it);
+			++written;
+		}
+	}
+	failed = failed || !ok;
+	--in_flight;
+	changed.notify_all();
+}
+
+std::vector<Uint8> FrameExporter::Y4mFrame(const Image& image) const {
+	static const char header[] = "FRAME\n";
+	size_t luma = size_t(width) * height, chroma = luma / 4;
+	std::vector<Uint8> frame(sizeof(header) - 1 + luma + 2 * chroma);
+	memcpy(frame.data(), header, sizeof(header) - 1);
+	Uint8* y = frame.data() + sizeof(header) - 1;
+	Uint8* u = y + luma;
+	Uint8* v = u + chroma;
+	const Uint8* rgba = image.getPixelsPtr();
+	auto clamp = [](float x) { return Uint8(std::min(std::max(x + 0.5f, 0.f), 255.f)); };
+	for (unsigned int j = 0; j < height; ++j) { //BT.601, full range as the header says
+		for (unsigned int i = 0; i < width; ++i) {
+			const Uint8* p = rgba + 4 * (size_t(j) * width + i);
+			y[size_t(j) * width + i] = clamp(0.299f * p[0] + 0.587f * p[1] + 0.114f * p[2]);
+		}
+	}
+	for (unsigned int j = 0; j < height / 2; ++j) { //average of each 2x2 block
+		for (unsigned int i = 0; i < width / 2; ++i) {
+			float r = 0, g = 0, b = 0;
+			for (int k = 0; k < 4; ++k) {
+				const Uint8* p = rgba + 4 * (size_t(2 * j + k / 2) * width + 2 * i + k % 2);
+				r += p[0];
+				g += p[1];
+				b += p[2];
+			}
+			r /= 4;
+			g /= 4;
+			b /= 4;
+			u[size_t(j) * (width / 2) + i] = clamp(128 - 0.168736f * r - 0.331264f * g + 0.5f * b);
+			v[size_t(j) * (width / 2) + i] = clamp(128 + 0.5f * r - 0.418688f * g - 0.081312f * b);
+		}
+	}
+	return frame;
+}
+
+bool FrameExporter::Finish() {
+	std::unique_lock<std::mutex> lock(mutex);
+	changed.wait(lock, [this] { return in_flight == 0; });
+	if (stream) {
+		fflush(stream);
+	}
+	return !failed;
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <cstdio>
+#include "ThreadPool.h"
+
+using namespace sf;
+
+enum class ExportFormat { PNG, Y4M };
+
+struct ExportSettings {
+	std::string path; //directory of PNGs, a .y4m file or "-" for a Y4M stream on stdout
+	unsigned int width = 1280, height = 720;
+	unsigned int fps = 60;
+	float seconds = 20;
+	unsigned int seed = 0; //of the planet
+	unsigned int threads = 0; //encoders, 0 - one per core
+};
+
+//Renders frames offscreen and encodes them on a pool of threads: numbered PNGs in a
+//directory, or one YUV4MPEG2 (4:2:0) stream to pipe into an external encoder. A frame is
+//encoded while the next ones are simulated and drawn; at most two per encoder are in
+//flight, so memory stays bounded when encoding is the slower side.
+class FrameExporter {
+private:
+	ExportFormat format;
+	std::string path;
+	unsigned int width, height, fps;
+	RenderTexture target;
+	bool ready = false;
+	FILE* stream = nullptr; //Y4M
+	std::mutex mutex;
+	std::condition_variable changed;
+	int in_flight = 0;
+	int max_in_flight;
+	size_t captured = 0;
+	size_t written = 0; //Y4M frames are written in order, the rest wait in encoded
+	std::map<size_t, std::vector<Uint8>> encoded;
+	bool failed = false;
+	ThreadPool encoders; //last, joined before the rest is destroyed
+
+	void Encode(const size_t& index, const Image& image);
+	std::vector<Uint8> Y4mFrame(const Image& image) const;
+public:
+	FrameExporter(const ExportFormat& format, const std::string& path, const unsigned int& width,
+		const unsigned int& height, const unsigned int& fps, const unsigned int& threads);
+	FrameExporter(const FrameExporter&) = delete;
+	FrameExporter& operator = (const FrameExporter&) = delete;
+	~FrameExporter();
+
+	bool IsReady() const; //false if the target or the output can't be created
+	RenderTarget& Target(); //draw a frame here, then Capture
+	void Capture(); //reads the frame back and hands it to the encoders
+	bool Finish(); //waits for every frame, false if any couldn't be written
+	size_t FrameCount() const;
+};
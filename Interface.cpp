@@ -1,9 +1,18 @@
 #include "Interface.h"
 #include<sstream>
+#include <algorithm>
+#include <cmath>
+
+static const float HUD_REFRESH = 0.1f; //s, numbers change at most 10 times a second
 
 Interface::Interface(const float& h, const float& a, const float& A_V, const float& V_X, const float& V_Y, const float& f, const float& x, const String& new_status) : height(h),
 angle(a), angular_velocity(A_V), velocity_X(V_X), velocity_Y(V_Y), fuel(f), Coordinate_X(x), status(new_status) {
-	font.loadFromFile("fonts/FRAHV.ttf");
+	for (int i = 0; i < STATUS; ++i) { //one line per field
+		fields[i].SetSize(20);
+		fields[i].SetPosition({ 0, float(i * gap) });
+	}
+	fields[STATUS].SetSize(40);
+	fields[STATUS].SetBold(true);
 }
 void Interface::SetHeight(const float& h) {
 	height = h;
@@ -26,104 +35,123 @@ void Interface::SetFuel(const float& f) {
 void Interface::SetCoordinate_X(const float& x) {
 	Coordinate_X = x;
 }
+void Interface::SetCoordinate_Y(const float& y) {
+	Coordinate_Y = y;
+}
+void Interface::SetLandingSite(const LandingSite* site, const float& x) {
+	site_exists = site != nullptr;
+	if (site_exists) {
+		site_distance = x < site->left ? site->left - x : (x > site->right ? site->right - x : 0);
+	}
+}
 void Interface::SetStatus(const String& s) {
 	status = s;
 }
-void Interface::Draw(RenderWindow& window, const View& v) {
-	std::ostringstream s_height;
-	s_height << "Height: " << height;
-	text_height.setString(s_height.str());
-	text_height.setPosition(v.getCenter().x - window_x() / 2, v.getCenter().y - window_y() / 2);
-	if (height < 3000) {
-		text_height.setFillColor(Color::Green);
-	}
-	else {
-		text_height.setFillColor(Color::Red);
-	}
-	window.draw(text_height);
-	std::ostringstream s_angle;
-	s_angle << "Angle: " << angle;
-	text_angle.setString(s_angle.str());
-	text_angle.setPosition(v.getCenter().x - window_x() / 2, v.getCenter().y - window_y() / 2 + gap);
-	text_angle.setFillColor(Color::Blue);
-	window.draw(text_angle);
-	std::ostringstream s_angular_velocity;
-	s_angular_velocity << "Angular_velocity: " << angular_velocity;
-	text_angular_velocity.setString(s_angular_velocity.str());
-	text_angular_velocity.setPosition(v.getCenter().x - window_x() / 2, v.getCenter().y - window_y() / 2 + 2*gap);
-	if (angular_velocity < 150) {
-		text_angular_velocity.setFillColor(Color::Green);
-	}
-	else if (angular_velocity > 150 && angular_velocity < 300) {
-		text_angular_velocity.setFillColor(Color::Yellow);
-	}
-	else {
-		text_angular_velocity.setFillColor(Color::Red);
-	}
-	window.draw(text_angular_velocity);
-	std::ostringstream s_velocity_X;
-	s_velocity_X << "velocity_X: " << velocity_X;
-	text_velocity_X.setString(s_velocity_X.str());
-	text_velocity_X.setPosition(v.getCenter().x - window_x() / 2, v.getCenter().y - window_y() / 2 + 3*gap);
-	if (abs(velocity_X) < 1500) {
-		text_velocity_X.setFillColor(Color::Green);
-	}
-	else if (abs(velocity_X) > 1500 && abs(velocity_X) < 3500) {
-		text_velocity_X.setFillColor(Color::Yellow);
-	}
-	else {
-		text_velocity_X.setFillColor(Color::Red);
-	}
-	window.draw(text_velocity_X);
-	std::ostringstream s_velocity_Y;
-	s_velocity_Y << "velocity_Y: " << -velocity_Y;
-	text_velocity_Y.setString(s_velocity_Y.str());
-	text_velocity_Y.setPosition(v.getCenter().x - window_x() / 2, v.getCenter().y - window_y() / 2 + 4*gap);
-	if (abs(velocity_Y) < 1500) {
-		text_velocity_Y.setFillColor(Color::Green);
-	}
-	else if (abs(velocity_Y) > 1500 && abs(velocity_Y) < 3500) {
-		text_velocity_Y.setFillColor(Color::Yellow);
-	}
-	else {
-		text_velocity_Y.setFillColor(Color::Red);
-	}
-	window.draw(text_velocity_Y);
-	std::ostringstream s_fuel;
-	s_fuel << "fuel: " << fuel << "/10";
+void Interface::Show(const FlightReadout& f) {
+	SetAngle(f.angle);
+	SetHeight(f.altitude);
+	SetAngVelocity(f.angular_velocity);
+	SetFuel(f.fuel);
+	SetVelocityX(f.velocity.x);
+	SetVelocityY(f.velocity.y);
+	SetCoordinate_X(f.position.x);
+	SetCoordinate_Y(-f.position.y);
+	SetLandingSite(f.site_exists ? &f.site : nullptr, f.center.x);
+	SetStatus(f.status);
+}
 
-	text_fuel.setString(s_fuel.str());
-	text_fuel.setPosition(v.getCenter().x - window_x() / 2, v.getCenter().y - window_y() / 2 + 5*gap);
-	if (fuel > 6) {
-		text_fuel.setFillColor(Color::Green);
-	}
-	else if (fuel > 3) {
-		text_fuel.setFillColor(Color::Yellow);
-	}
-	else {
-		text_fuel.setFillColor(Color::Red);
+FlightReadout ReadFlight(const Ship& ship, const Surface& surface) {
+	FlightReadout f;
+	f.center = ship.GetCenterPosition();
+	f.angle = ship.GetAngle();
+	f.altitude = surface.Sampler().Altitude(ship.GetPosition());
+	for (const auto& v : ship.GetVertexes()) {
+		f.altitude = std::min(f.altitude, surface.Sampler().Altitude(v)); //the lowest corner
+	}
+	f.angular_velocity = ship.GetAngleVelocity();
+	f.fuel = ship.GetFuel();
+	f.velocity = ship.GetVelocity();
+	f.position = ship.GetPosition();
+	const LandingSite* site = surface.GetLandingSites().Nearest(f.center.x);
+	f.site_exists = site != nullptr;
+	if (site) {
+		f.site = *site;
+	}
+	f.status = ship.GetStatusText();
+	return f;
+}
+
+void Interface::SetField(const FieldId& id, const String& text, const Color& color) {
+	SdfText& f = fields[id];
+	if (f.GetString() != text) {
+		f.SetString(text); //lays it out
+		dirty = true;
 	}
-	window.draw(text_fuel);
-	std::ostringstream s_Position;
-	s_Position << "Coordinate: (" << Coordinate_X << "," << height << ")";
-	Position.setString(s_Position.str());
-	Position.setPosition(v.getCenter().x - window_x() / 2, v.getCenter().y - window_y() / 2 + 6*gap);
-	Position.setFillColor(Color::Blue);
-	window.draw(Position);
-	
-	text_status.setString(status);
-	text_status.setPosition(v.getCenter().x - text_status.getLocalBounds().width/2 , v.getCenter().y - window_y() / 2 + 6*gap);
-	text_status.setFillColor(Color::Blue);
-	text_status.setStyle(sf::Text::Bold);
-	if (status == "You are in flight") {
-		text_status.setFillColor(Color::Green);
+	if (f.GetColor() != color) {
+		f.SetColor(color);
+		dirty = true;
 	}
-	else if (status == "Landing succesfull!") {
-		text_status.setFillColor(Color::Green);
+}
+
+static Color Level(const float& value, const float& yellow, const float& red) { //green below yellow
+	return value < yellow ? Color::Green : (value > yellow && value < red ? Color::Yellow : Color::Red);
+}
+
+void Interface::Format() {
+	std::ostringstream s;
+	s << "Altitude: " << height;
+	SetField(HEIGHT, s.str(), height < 3000 ? Color::Green : Color::Red);
+	s.str("");
+	s << "Angle: " << angle;
+	SetField(ANGLE, s.str(), Color::Blue);
+	s.str("");
+	s << "Angular_velocity: " << angular_velocity;
+	SetField(ANGULAR_VELOCITY, s.str(), Level(angular_velocity, 150, 300));
+	s.str("");
+	s << "velocity_X: " << velocity_X;
+	SetField(VELOCITY_X, s.str(), Level(std::abs(velocity_X), 1500, 3500));
+	s.str("");
+	s << "velocity_Y: " << -velocity_Y;
+	SetField(VELOCITY_Y, s.str(), Level(std::abs(velocity_Y), 1500, 3500));
+	s.str("");
+	s << "fuel: " << fuel << "/10";
+	SetField(FUEL, s.str(), fuel > 6 ? Color::Green : (fuel > 3 ? Color::Yellow : Color::Red));
+	s.str("");
+	s << "Coordinate: (" << Coordinate_X << "," << Coordinate_Y << ")";
+	SetField(POSITION, s.str(), Color::Blue);
+	s.str("");
+	if (site_exists) {
+		s << "Landing site: " << site_distance;
 	}
 	else {
-		text_status.setFillColor(Color::Red);
+		s << "Landing site: none";
 	}
-	window.draw(text_status);
+	SetField(SITE, s.str(), site_exists && site_distance == 0 ? Color::Green : Color::Yellow);
+}
 
-}
\ No newline at end of file
+void Interface::Draw(RenderTarget& window, const View& v, const float& dt) {
+	since_format += dt; //not the clock: an export runs at its own pace, the HUD still changes every HUD_REFRESH of the flight
+	if (!formatted || since_format >= HUD_REFRESH) {
+		Format();
+		since_format = 0;
+		formatted = true;
+	}
+	bool good = status == "You are in flight" || status == "Landing succesfull!";
+	SetField(STATUS, status, good ? Color::Green : Color::Red); //follows the ship at once
+	if (v.getSize().x != view_width) {
+		view_width = v.getSize().x;
+		dirty = true;
+	}
+	if (dirty) {
+		SdfText& s = fields[STATUS];
+		s.SetPosition({ (view_width - s.GetLocalBounds().width) / 2, float(6 * gap) });
+		hud.Clear();
+		for (const SdfText& f : fields) {
+			hud.Add(f);
+		}
+		dirty = false;
+	}
+	RenderStates states;
+	states.transform.translate(v.getCenter() - v.getSize() / 2.f);
+	hud.Draw(window, states);
+}
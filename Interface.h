@@ -1,27 +1,54 @@
 #pragma once
 #include "ship.h"
 #include<string.h>
+#include <vector>
+#include "TextBatch.h"
+
+//What the HUD shows of a flight, read between steps. The game loop, the simulation
+//thread and the export all read it with ReadFlight, so they show the same numbers.
+struct FlightReadout {
+	Vector2f center; //of the ship, the camera follows it
+	float angle = 0;
+	float altitude = 0; //of the lowest corner
+	float angular_velocity = 0;
+	float fuel = 0;
+	Vector2f velocity;
+	Vector2f position;
+	bool site_exists = false;
+	LandingSite site; //the nearest one
+	String status;
+};
+
+FlightReadout ReadFlight(const Ship& ship, const Surface& surface);
+
 class Interface  {
 private:
-	Font font;
+	//Each field keeps its text and glyph quads and is laid out again only when the text
+	//changes; numbers are formatted at HUD_REFRESH. The HUD is one batch of SDF text,
+	//rebuilt only on a change and placed relative to the view.
+	enum FieldId { HEIGHT, ANGLE, ANGULAR_VELOCITY, VELOCITY_X, VELOCITY_Y, FUEL, POSITION, SITE, STATUS, FIELD_COUNT };
 	int gap = 20;
+	SdfText fields[FIELD_COUNT]; //positions from the top left corner of the view
+	TextBatch hud;
+	bool dirty = true;
+	float view_width = 0; //the status is centered in it
+	float since_format = 0; //s of the flight, numbers are formatted when it passes HUD_REFRESH
+	bool formatted = false;
 
 	float height ;
-	Text text_height{ "", font, 20 };
 	float angle;
-	Text text_angle{ "", font, 20 };
 	float angular_velocity;
-	Text text_angular_velocity{ "", font, 20 };
 	float velocity_X;
-	Text text_velocity_X{ "", font, 20 };
 	float velocity_Y;
-	Text text_velocity_Y{ "", font, 20 };
 	float fuel;
-	Text text_fuel{ "", font, 20 };
 	float Coordinate_X;
-	Text Position{ "", font, 20 };
+	float Coordinate_Y = 0;
+	float site_distance = 0; //to the nearest landing site, 0 - above it
+	bool site_exists = false;
 	String status;
-	Text text_status{ "", font, 40 };
+
+	void SetField(const FieldId& id, const String& text, const Color& color); //lays out only on change
+	void Format(); //texts and colors of the numbers
 public:
 	Interface(const float& h, const float& a, const float& A_V, const float& V_X, const float& V_Y, const float& f, const float& X, const String& new_status);
 	void SetHeight(const float& h) ;
@@ -31,7 +58,10 @@ public:
 	void SetVelocityY(const float& VelY) ;
 	void SetFuel(const float& f);
 	void SetCoordinate_X(const float& x);
+	void SetCoordinate_Y(const float& y);
 	void SetStatus(const String& s);
-	void Draw(RenderWindow& window, const View& v);
+	void SetLandingSite(const LandingSite* site, const float& x);
+	void Show(const FlightReadout& flight); //every field at once
+	void Draw(RenderTarget& window, const View& v, const float& dt); //dt - flight time since the last Draw
 
 };
\ No newline at end of file
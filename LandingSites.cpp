@@ -0,0 +1,101 @@
+#include "LandingSites.h"
+#include "Surface.h"
+#include <algorithm>
+
+float LandingSite::Center() const { return (left + right) / 2; }
+float LandingSite::Width() const { return right - left; }
+
+static bool landable(const std::vector<float>& heights, const std::vector<Material>& materials,
+	const int& i, const float& max_rise) { //segment [i, i + 1]
+	return abs(heights[i + 1] - heights[i]) < max_rise &&
+		materials[i] == Material::ROCK && materials[i + 1] == Material::ROCK;
+}
+
+void LandingSites::Scan(const std::vector<float>& heights, const std::vector<Material>& materials,
+	const float& left_x, const float& spacing, const float& min_width, int first, int last,
+	std::vector<LandingSite>& out) {
+	float max_rise = tan(RAD * MAX_ANGLE) * spacing;
+	int start = -1; //first sample of the current flat run
+	for (int i = first; i + 1 < last; ++i) {
+		bool flat = landable(heights, materials, i, max_rise);
+		if (flat && start < 0) {
+			start = i;
+		}
+		if ((!flat || i + 2 == last) && start >= 0) {
+			int end = flat ? i + 1 : i;
+			LandingSite site{ left_x + start * spacing, left_x + end * spacing };
+			if (site.Width() >= min_width) {
+				out.push_back(site);
+			}
+			start = -1;
+		}
+	}
+}
+
+void LandingSites::Build(const std::vector<float>& heights, const std::vector<Material>& materials,
+	const float& left_x, const float& spacing, const float& min_width) {
+	sites.clear();
+	Scan(heights, materials, left_x, spacing, min_width, 0, heights.size(), sites);
+}
+
+void LandingSites::Rebuild(const std::vector<float>& heights, const std::vector<Material>& materials,
+	const float& left_x, const float& spacing, const float& min_width, int first, int last) {
+	int count = heights.size();
+	if (count < 2) {
+		sites.clear();
+		return;
+	}
+	//segments [first, last) touch an edited sample; widen them to whole flat runs,
+	//so every site that can change lies inside and the rest stay valid
+	float max_rise = tan(RAD * MAX_ANGLE) * spacing;
+	first = std::max(first - 1, 0);
+	last = std::min(last, count - 1);
+	while (first > 0 && landable(heights, materials, first - 1, max_rise)) { --first; }
+	while (last < count - 1 && landable(heights, materials, last, max_rise)) { ++last; }
+
+	float x_left = left_x + first * spacing;
+	float x_right = left_x + last * spacing;
+	auto from = std::lower_bound(sites.begin(), sites.end(), x_left,
+		[](const LandingSite& site, const float& x) { return site.right < x; });
+	auto to = std::upper_bound(from, sites.end(), x_right,
+		[](const float& x, const LandingSite& site) { return x < site.left; });
+	std::vector<LandingSite> found;
+	Scan(heights, materials, left_x, spacing, min_width, first, last + 1, found);
+	from = sites.erase(from, to);
+	sites.insert(from, found.begin(), found.end());
+}
+
+void LandingSites::Clear() { sites.clear(); }
+
+bool LandingSites::IsLandable(const float& x) const {
+	auto it = std::lower_bound(sites.begin(), sites.end(), x,
+		[](const LandingSite& site, const float& x) { return site.right < x; });
+	return it != sites.end() && it->left <= x;
+}
+
+const LandingSite* LandingSites::Nearest(const float& x) const {
+	if (sites.empty()) {
+		return nullptr;
+	}
+	auto it = std::lower_bound(sites.begin(), sites.end(), x,
+		[](const LandingSite& site, const float& x) { return site.right < x; });
+	if (it == sites.end()) {
+		return &sites.back();
+	}
+	if (it == sites.begin() || it->left <= x) {
+		return &*it;
+	}
+	auto prev = it - 1;
+	return (x - prev->right) < (it->left - x) ? &*prev : &*it;
+}
+
+std::vector<LandingSite> LandingSites::Within(const float& x_left, const float& x_right) const {
+	auto first = std::lower_bound(sites.begin(), sites.end(), x_left,
+		[](const LandingSite& site, const float& x) { return site.right < x; });
+	auto last = std::upper_bound(first, sites.end(), x_right,
+		[](const float& x, const LandingSite& site) { return x < site.left; });
+	return std::vector<LandingSite>(first, last);
+}
+
+size_t LandingSites::Count() const { return sites.size(); }
+const std::vector<LandingSite>& LandingSites::GetSites() const { return sites; }
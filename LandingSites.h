@@ -0,0 +1,40 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#define MAX_ANGLE 20 //steepest ground (degrees) a ship can land on
+
+enum class Material : uint8_t;
+
+struct LandingSite {
+	float left, right;
+
+	float Center() const;
+	float Width() const;
+};
+
+//Sorted, disjoint intervals of ground that is flat enough and bare rock.
+//Built once per planet, every query is a binary search.
+class LandingSites {
+private:
+	std::vector<LandingSite> sites;
+
+	static void Scan(const std::vector<float>& heights, const std::vector<Material>& materials,
+		const float& left_x, const float& spacing, const float& min_width, int first, int last,
+		std::vector<LandingSite>& out); //samples [first, last)
+public:
+	void Build(const std::vector<float>& heights, const std::vector<Material>& materials,
+		const float& left_x, const float& spacing, const float& min_width);
+	//after samples [first, last) changed, in time of the changed runs, not the planet
+	void Rebuild(const std::vector<float>& heights, const std::vector<Material>& materials,
+		const float& left_x, const float& spacing, const float& min_width, int first, int last);
+	void Clear();
+
+	bool IsLandable(const float& x) const;
+	const LandingSite* Nearest(const float& x) const; //nullptr if there are no sites
+	std::vector<LandingSite> Within(const float& x_left, const float& x_right) const;
+
+	size_t Count() const;
+	const std::vector<LandingSite>& GetSites() const;
+};
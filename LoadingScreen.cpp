@@ -0,0 +1,89 @@
+#include "LoadingScreen.h"
+#include "ThreadPool.h"
+#include "Surface.h"
+
+LoadingScreen::LoadingScreen(const std::string& t) : tasks(std::make_shared<Tasks>()), title(t) {}
+
+LoadingScreen::~LoadingScreen() {
+	Join();
+}
+
+void LoadingScreen::Join() {
+	std::unique_lock<std::mutex> lock(tasks->mutex);
+	tasks->finished.wait(lock, [this] { return tasks->running == 0; });
+}
+
+void LoadingScreen::Start(const std::string& label, std::function<void()> task) {
+	auto finished = std::make_shared<std::atomic<bool>>(false); //for the progress bar
+	std::shared_ptr<Tasks> t = tasks;
+	{
+		std::lock_guard<std::mutex> lock(t->mutex);
+		++t->running;
+	}
+	Workers().Push([task, finished, t]() {
+		task();
+		*finished = true;
+		std::lock_guard<std::mutex> lock(t->mutex);
+		--t->running;
+		t->finished.notify_all();
+	});
+	Wait(label, [finished]() { return finished->load(); });
+}
+
+void LoadingScreen::Wait(const std::string& label, std::function<bool()> done) {
+	steps.push_back({ label, done });
+}
+
+bool LoadingScreen::Run(RenderWindow& window) {
+	float w = window_x(), h = window_y();
+	RectangleShape frame({ w / 2, 30 });
+	frame.setPosition(w / 4, h / 2);
+	frame.setFillColor(Color::Transparent);
+	frame.setOutlineColor(Color(0x0000f0ff));
+	frame.setOutlineThickness(2);
+	RectangleShape bar({ 0, 30 });
+	bar.setPosition(frame.getPosition());
+	bar.setFillColor(Color(0x0000b0ff));
+	SdfText caption(title, 40);
+	caption.SetPosition({ (w - caption.GetLocalBounds().width) / 2, h / 2 - 100 });
+	caption.SetColor(Color(0x0000f0ff));
+	SdfText step_text("", 25);
+	step_text.SetColor(Color(0x0000f080));
+	TextBatch labels;
+
+	while (window.isOpen()) {
+		size_t done = 0;
+		const Step* current = nullptr; //first unfinished
+		for (const Step& step : steps) {
+			if (step.done()) {
+				++done;
+			}
+			else if (!current) {
+				current = &step;
+			}
+		}
+		if (!current) {
+			return true;
+		}
+		Event event;
+		while (window.pollEvent(event)) {
+			if (event.type == Event::Closed) {
+				window.close();
+			}
+		}
+		bar.setSize({ frame.getSize().x * done / steps.size(), frame.getSize().y });
+		step_text.SetString(current->label);
+		step_text.SetPosition({ (w - step_text.GetLocalBounds().width) / 2, h / 2 + 50 });
+		labels.Clear();
+		labels.Add(caption);
+		labels.Add(step_text);
+
+		window.setView(View(FloatRect(0, 0, w, h)));
+		window.clear();
+		window.draw(frame);
+		window.draw(bar);
+		labels.Draw(window);
+		window.display();
+	}
+	return false;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <functional>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <string>
+#include "TextBatch.h"
+
+using namespace sf;
+
+//Keeps the window alive while the world is built on the workers: a progress bar of the
+//finished steps at full frame rate. Steps run on Workers() (or wait for work started
+//elsewhere); whatever needs the GL context is left to the caller after Run.
+class LoadingScreen {
+private:
+	struct Step {
+		std::string label;
+		std::function<bool()> done;
+	};
+	struct Tasks { //of Start, shared with the workers running them
+		std::mutex mutex;
+		std::condition_variable finished;
+		int running = 0;
+	};
+	std::vector<Step> steps;
+	std::shared_ptr<Tasks> tasks;
+	std::string title;
+public:
+	LoadingScreen(const std::string& title);
+	LoadingScreen(const LoadingScreen&) = delete;
+	LoadingScreen& operator = (const LoadingScreen&) = delete;
+	~LoadingScreen(); //Join, the tasks may use the caller's locals
+
+	void Start(const std::string& label, std::function<void()> task); //runs task on a worker
+	void Wait(const std::string& label, std::function<bool()> done); //polls a condition
+	//until all steps are done; shows nothing if they already are, false if the window was closed
+	bool Run(RenderWindow& window);
+	void Join(); //waits for the tasks of Start, also after a Run cut short by closing the window
+};
@@ -100,11 +100,11 @@ void Lunar_Lander_Mark1::control() {
     }
 }
 
-void Lunar_Lander_Mark1::DrawShip(RenderWindow& window) const {
-    Draw(window);
+void Lunar_Lander_Mark1::DrawShip(SpriteBatch& batch) const {
+    DrawSprites(batch);
     for (const auto& e : engines) {
         if (e.second.If_on()) {
-            e.second.Draw(window);
+            e.second.DrawSprites(batch);
         }
     }
 }
\ No newline at end of file
@@ -0,0 +1,118 @@
+#include "MappedFile.h"
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <direct.h>
+#include <errno.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <cstdio>
+#include <errno.h>
+#endif
+
+MappedFile::MappedFile(const std::string& path) { Open(path); }
+MappedFile::~MappedFile() { Close(); }
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::string& path) {
+	Close();
+	HANDLE f = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (f == INVALID_HANDLE_VALUE) { return false; }
+	file = f;
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(f, &file_size) || file_size.QuadPart == 0) { Close(); return false; }
+	mapping = CreateFileMappingA(f, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping == NULL) { Close(); return false; }
+	data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	if (data == nullptr) { Close(); return false; }
+	size = size_t(file_size.QuadPart);
+	return true;
+}
+
+void MappedFile::Close() {
+	if (data) { UnmapViewOfFile(data); }
+	if (mapping) { CloseHandle(mapping); }
+	if (file) { CloseHandle(file); }
+	data = nullptr;
+	mapping = nullptr;
+	file = nullptr;
+	size = 0;
+}
+
+bool MakeDirectory(const std::string& path) {
+	return _mkdir(path.c_str()) == 0 || errno == EEXIST;
+}
+
+bool RenameFile(const std::string& from, const std::string& to) {
+	return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+}
+
+std::vector<std::string> ListFiles(const std::string& directory) {
+	std::vector<std::string> names;
+	WIN32_FIND_DATAA found;
+	HANDLE search = FindFirstFileA((directory + "/*").c_str(), &found);
+	if (search == INVALID_HANDLE_VALUE) { return names; }
+	do {
+		if (!(found.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) { names.push_back(found.cFileName); }
+	} while (FindNextFileA(search, &found));
+	FindClose(search);
+	std::sort(names.begin(), names.end());
+	return names;
+}
+
+#else
+
+bool MappedFile::Open(const std::string& path) {
+	Close();
+	file = open(path.c_str(), O_RDONLY);
+	if (file < 0) { return false; }
+	struct stat st;
+	if (fstat(file, &st) != 0 || st.st_size == 0) { Close(); return false; }
+	void* p = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+	if (p == MAP_FAILED) { Close(); return false; }
+	data = static_cast<const char*>(p);
+	size = size_t(st.st_size);
+	return true;
+}
+
+void MappedFile::Close() {
+	if (data) { munmap(const_cast<char*>(data), size); }
+	if (file >= 0) { close(file); }
+	data = nullptr;
+	file = -1;
+	size = 0;
+}
+
+bool MakeDirectory(const std::string& path) {
+	return mkdir(path.c_str(), 0755) == 0 || errno == EEXIST;
+}
+
+bool RenameFile(const std::string& from, const std::string& to) {
+	return rename(from.c_str(), to.c_str()) == 0;
+}
+
+std::vector<std::string> ListFiles(const std::string& directory) {
+	std::vector<std::string> names;
+	DIR* dir = opendir(directory.c_str());
+	if (dir == nullptr) { return names; }
+	while (dirent* entry = readdir(dir)) {
+		struct stat st;
+		std::string path = directory + "/" + entry->d_name;
+		if (stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode)) { names.push_back(entry->d_name); }
+	}
+	closedir(dir);
+	std::sort(names.begin(), names.end());
+	return names;
+}
+
+#endif
+
+bool MappedFile::IsOpen() const { return data != nullptr; }
+const char* MappedFile::Data() const { return data; }
+size_t MappedFile::Size() const { return size; }
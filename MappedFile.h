@@ -0,0 +1,34 @@
+#pragma once
+#include <string>
+#include <cstddef>
+#include <vector>
+
+//Read-only memory mapping of a whole file (mmap / MapViewOfFile).
+class MappedFile {
+private:
+	const char* data = nullptr;
+	size_t size = 0;
+#ifdef _WIN32
+	void* file = nullptr;
+	void* mapping = nullptr;
+#else
+	int file = -1;
+#endif
+public:
+	MappedFile() {}
+	MappedFile(const std::string& path);
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator = (const MappedFile&) = delete;
+	~MappedFile();
+
+	bool Open(const std::string& path);
+	void Close();
+
+	bool IsOpen() const;
+	const char* Data() const;
+	size_t Size() const;
+};
+
+bool MakeDirectory(const std::string& path); //true if it exists afterwards
+bool RenameFile(const std::string& from, const std::string& to); //replaces to in one step, readers see the old or the new file
+std::vector<std::string> ListFiles(const std::string& directory); //names of the regular files, sorted
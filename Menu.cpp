@@ -4,6 +4,7 @@ using namespace sf;
 
 int SoundVolume;
 int MusicVolume;
+bool SimulationThread = false;
 
 void Menu(RenderWindow & window) {
     unsigned int seed = time(NULL);
@@ -32,11 +33,8 @@ void Menu(RenderWindow & window) {
     music.setVolume(MusicVolume);
     music.play();
 
-    Text MusicBy;
-    Font font;
-    font.loadFromFile("fonts/FRAHV.ttf");
-    MusicBy = Text("Music: Kevin MacLeod - Deep Haze", font, 30);
-    MusicBy.setPosition({ window_x() - MusicBy.getLocalBounds().width-30, window_y() - MusicBy.getLocalBounds().height -30});
+    SdfText MusicBy("Music: Kevin MacLeod - Deep Haze", 30);
+    MusicBy.SetPosition({ window_x() - MusicBy.GetLocalBounds().width-30, window_y() - MusicBy.GetLocalBounds().height -30});
 
     Object title("Title.png", { 0, 0 }, 500, 200, 0);
     title.SetPosition({ (window_x() - title.GetWidth()) / 2, 20 }, 0);
@@ -48,17 +46,17 @@ void Menu(RenderWindow & window) {
     buttons.push_back(Button( "Start", { x_pos, 300 } ));
     buttons.push_back(Button("Settings", { x_pos, 450 }));
     buttons.push_back(Button( "Exit", { x_pos, 600 } ));
-	Texture bg_texture;
-	bg_texture.loadFromFile("images/background.png");
-	bg_texture.setRepeated(true);
+	std::shared_ptr<const Texture> bg_texture = LoadTexture("images/background.png", false, true);
 	Sprite bg_sprite;
-	bg_sprite.setTexture(bg_texture);
+	bg_sprite.setTexture(*bg_texture);
 	bg_sprite.setTextureRect({ 0, 0, int(window_x()), int(window_y()) });
 	
 	int selected_button = 0;
 
     View view; 
 
+	SpriteBatch sprites; //one draw call for the whole screen with the atlas
+	TextBatch labels; //and one for all the texts
 	while (isMenu && window.isOpen()) {
 		Event event;
 		
@@ -115,12 +113,18 @@ void Menu(RenderWindow & window) {
 		}
 
 		buttons[selected_button].SetSelected(1);
+		sprites.Clear();
+		labels.Clear();
 		for (int i = 0; i < buttons.size(); ++i) {
-			buttons[i].Draw(window);
+			buttons[i].DrawSprites(sprites);
 		}
-
-        title.Draw(window);
-        window.draw(MusicBy);
+        title.DrawSprites(sprites);
+        sprites.Draw(window);
+		for (int i = 0; i < buttons.size(); ++i) {
+			buttons[i].DrawLabels(labels);
+		}
+        labels.Add(MusicBy);
+        labels.Draw(window);
 
 		window.display();
 	}
@@ -128,6 +132,64 @@ void Menu(RenderWindow & window) {
 
 Lander_Parametr par; //for STM32
 
+//The flight with SimulationThread: the simulation steps on its own thread and this loop
+//only draws its newest snapshot. The debug overlays (forces, way, collision model) read
+//the live ship and are left out. Returns false to go to the main menu.
+static bool FlyOnThread(RenderWindow& window, Ship* lander, Surface& surface, Space& space, bool& Restart) {
+    Interface interf(lander->GetHeight(), lander->GetAngle(), 0, 0, 0, 0, 0, "Strat");
+    View view = GameView(window, lander->GetCenterPosition());
+    Simulation sim(lander, surface, SIMULATION_RATE, [](Ship* ship) { //the ship is the thread's from here
+        par.data_update(ship);
+        USART(par, par.data_to_send()); //for STM32
+    });
+
+    bool isPaused = 0;
+    bool crater_dug = 0;
+    Clock frame;
+    while (window.isOpen() && !Restart) {
+        Event event;
+        while (window.pollEvent(event)) {
+            if (event.type == sf::Event::Closed) {
+                window.close();
+            }
+            if (event.type == Event::KeyPressed && event.key.code == Keyboard::Escape) {
+                window.setView(View({ 0, 0, float(window_x()), float(window_y()) }));
+                isPaused = (isPaused + 1) % 2;
+                window.clear();
+            }
+        }
+        float dt = std::min(frame.restart().asSeconds(), 0.3f); //animations only
+        sim.SetPaused(isPaused);
+        const FlightSnapshot& s = sim.Latest();
+        if (s.crashed && !crater_dug) {
+            crater_dug = 1;
+            sim.Apply([&surface, &s] { surface.Crater(s.crater_x, s.crater_radius, s.crater_depth); });
+        }
+
+        window.clear();
+        space.Draw(window);
+        s.ship.Draw(window);
+        view = GameView(window, s.flight.center);
+        window.setView(view);
+        surface.Draw(window);
+
+        interf.Show(s.flight);
+        interf.Draw(window, view, dt);
+
+        if (isPaused) {
+            if (!PauseMenu(window, isPaused, Restart, view)) { //if main menu
+                return false;
+            }
+        }
+        else {
+            space.Update(view);
+            surface.Update(dt);
+        }
+        window.display();
+    }
+    return true;
+}
+
 void StartGame(RenderWindow& window) {
 	
     Music music;
@@ -150,6 +212,7 @@ void StartGame(RenderWindow& window) {
     music.setVolume(10);
     music.play();
 
+    Workers().Push([] { Space::Prefetch("Space2.png"); }); //while the planet is set up
     bool if_Menu = 0;
     Surface surface = PlanetSettings(window, if_Menu);
     if(if_Menu) {
@@ -158,7 +221,7 @@ void StartGame(RenderWindow& window) {
 
     Vector2f start_pos = Vector2f(0, surface.YtoX(200) - 500);
 
-    Space space("Space2.png", start_pos);
+    Space space("Space2.png", start_pos, surface.GetSeed());
 
     while (!if_Menu) {
 
@@ -166,23 +229,34 @@ void StartGame(RenderWindow& window) {
         //Lunar_Lander_Mark1 l(Vector2f(0, s.YtoX(200) - 500));
         //RickAndMorty l(Vector2f(0, s.YtoX(200) - 500));   
 
+        surface.Restore(); //craters of the last attempt
         Ship* lander = ShipSettings(window, start_pos, if_Menu);
         lander->AddMainForces(surface.GetGravity());
         if (if_Menu) {
             return;
         }
 
+        if (SimulationThread) {
+            bool Restart = 0;
+            bool to_menu = !FlyOnThread(window, lander, surface, space, Restart);
+            delete lander;
+            if (to_menu || !window.isOpen()) {
+                return;
+            }
+            continue;
+        }
+
         Interface interf(lander->GetHeight(), lander->GetAngle(), 0, 0, 0, 0, 0, "Strat");
 
-        View view;
-        view.setCenter(sf::Vector2f(window_x() / 2, window_y() / 2));
-        view.setSize(sf::Vector2f(window_x(), window_y()));
+        View view = GameView(window, lander->GetCenterPosition());
 
         float dt = 0, time = 0;
         Clock deltaTime;
 
         bool isPaused = 0;
         bool Restart = 0;
+        bool crashed = 0; //the crater is left once
+        SpriteBatch sprites; //ship and engines
 
         while (window.isOpen() && !Restart)
         {
@@ -214,24 +288,19 @@ void StartGame(RenderWindow& window) {
 
             space.Draw(window);
 
-            lander->DrawShip(window);
+            sprites.Clear();
+            lander->DrawShip(sprites);
+            sprites.Draw(window);
             lander->draw_all(window, true, true, true, true, true);
             lander->DrawFlyStatus(dt);
 
-            view.setCenter(lander->GetCenterPosition());
+            view = GameView(window, lander->GetCenterPosition()); //world units, scaled to the window
             window.setView(view);
 
             surface.Draw(window);
 
-            interf.SetAngle(lander->GetAngle());
-            interf.SetHeight(-lander->GetPosition().y);
-            interf.SetAngVelocity(lander->GetAngleVelocity());
-            interf.SetFuel(lander->GetFuel());
-            interf.SetVelocityX(lander->GetVelocity().x);
-            interf.SetVelocityY(lander->GetVelocity().y);
-            interf.SetCoordinate_X(lander->GetPosition().x);
-            interf.SetStatus(lander->GetStatusText());
-            interf.Draw(window, view);
+            interf.Show(ReadFlight(*lander, surface));
+            interf.Draw(window, view, dt);
             //END_DRAWING
 
             if (isPaused) {
@@ -246,6 +315,11 @@ void StartGame(RenderWindow& window) {
                 //lander->updateAirForce(surface.GetAirDensity());
                 lander->UpdateShipPosition(dt);
                 lander->CollisionDetection(surface, window);
+                int status = lander->GetFlyStatus();
+                if (!crashed && status >= 2 && status <= 5) { //bad landing
+                    crashed = 1;
+                    surface.Crater(lander->GetCenterPosition().x, lander->GetWidth(), lander->GetHeight() / 2);
+                }
                 //l.control_STM(par);
 
                 space.Update(view);
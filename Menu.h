@@ -18,13 +18,17 @@
 #include "Dron.h"
 #include "Interface.h"
 #include "Usart.h"
+#include "Simulation.h"
+#include "FrameExporter.h"
 
 extern int SoundVolume;
 extern int MusicVolume;
+extern bool SimulationThread; //physics on its own thread, "--sim-thread"
 
 void Menu(RenderWindow& window);
 void StartGame(RenderWindow& window);
 void Settings(RenderWindow& window, Music& music);
 Surface PlanetSettings(RenderWindow& window, bool& if_back);
 bool PauseMenu(RenderWindow& window, bool& isPause, bool& Restart, View& view);
-Ship* ShipSettings(RenderWindow& window, const Vector2f&, bool& if_Menu);
\ No newline at end of file
+Ship* ShipSettings(RenderWindow& window, const Vector2f&, bool& if_Menu);
+bool ExportFlight(const ExportSettings& settings); //a flight rendered offscreen, "--export"
\ No newline at end of file
@@ -5,30 +5,42 @@ using namespace sf;
 Object::Object(const String& f, const Vector2f& new_position,
 	const float& w, const float& h, const float& start_angle)
 	: file(f), height(h), width(w), position(new_position), angle(start_angle) {
-	//buffer.loadFromFile("sounds/" + f_sound);
-	//sound.setBuffer(buffer);
-	image.loadFromFile("images/" + f);
-	//image.createMaskFromColor(Color(255, 255, 255));
-	texture.loadFromImage(image);
-	sprite.setTexture(texture);
-	sprite.setTextureRect(IntRect(0, 0, w, h));
+	SetImage(false, false);
 	sprite.setPosition(position.x, position.y);
 	sprite.rotate(angle);
 }
 
 Object::Object(const String& f, const Vector2f& new_position, const float& start_angle)
 	: file(f), position(new_position), angle(start_angle) {
-	image.loadFromFile("images/" + f);
-	height = image.getSize().y;
-	width = image.getSize().x;
-	//image.createMaskFromColor(Color(255, 255, 255));
-	texture.loadFromImage(image);
-	sprite.setTexture(texture);
-	sprite.setTextureRect(IntRect(0, 0, width, height));
+	SetImage(false, true);
 	sprite.setPosition(position.x, position.y);
 	sprite.rotate(angle);
 }
 
+void Object::SetImage(const bool& mask_black, const bool& fit_image) {
+	std::string path = "images/" + file;
+	AtlasRegion region;
+	if (Atlas().Find(path, mask_black, region)) {
+		if (fit_image) {
+			width = region.rect.width;
+			height = region.rect.height;
+		}
+		if (width <= region.rect.width && height <= region.rect.height) { //a bigger rect would show the neighbours
+			texture.reset();
+			sprite.setTexture(*region.texture);
+			sprite.setTextureRect(IntRect(region.rect.left, region.rect.top, width, height));
+			return;
+		}
+	}
+	texture = LoadTexture(path, mask_black);
+	if (fit_image) {
+		width = texture->getSize().x;
+		height = texture->getSize().y;
+	}
+	sprite.setTexture(*texture);
+	sprite.setTextureRect(IntRect(0, 0, width, height));
+}
+
 void Object::VertexesUpdate() {
 	Vector2f p_1 = { width * cos(RAD * angle), width * sin(RAD * angle) };
 	Vector2f p_2 = p_1 + Vector2f(-height * sin(RAD * angle), height * cos(RAD * angle));
@@ -57,11 +69,7 @@ Sprite& Object::Sprite() {
 }
 
 Object::Object(const Object& o) : position(o.position), height(o.height), width(o.width), angle(o.angle), exist(o.exist), file(o.file) {
-	image.loadFromFile("images/" + file);
-	image.createMaskFromColor(Color(0,0,0));
-	texture.loadFromImage(image);
-	sprite.setTexture(texture);
-	sprite.setTextureRect(IntRect(0, 0, width, height));
+	SetImage(true, false); //copies are masked
 	sprite.setPosition(position.x, position.y);
 	sprite.rotate(angle);
 }
@@ -92,6 +100,8 @@ void Object::SetPosition(const Vector2f& new_position, const float& new_angle) {
 	VertexesUpdate();
 }
 void Object::Draw(RenderWindow& window) const { window.draw(sprite); }
+void Object::DrawSprites(SpriteBatch& batch) const { batch.Add(sprite); }
+void Object::DrawLabels(TextBatch&) const {}
 
 void Object::SetColor(const Color& c) {
 	sprite.setColor(c);
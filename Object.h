@@ -4,6 +4,10 @@
 #include <string>
 #include <vector>
 #include "Geom/Geometric.h"
+#include "ResourceCache.h"
+#include "TextureAtlas.h"
+#include "SpriteBatch.h"
+#include "TextBatch.h"
 
 //#define PI 3.1415f
 #define RAD (PI / 180.f)
@@ -17,12 +21,10 @@ protected:
 	std::vector<Vector2f> vertexes;
 	bool exist = true;
 	String file;
-	Image image;
-	Texture texture;
+	std::shared_ptr<const Texture> texture; //shared by every object of the same file, empty if in the atlas
 	Sprite sprite;
 
-	SoundBuffer buffer;
-	Sound sound;
+	void SetImage(const bool& mask_black, const bool& fit_image); //sprite of file, fit_image - take the size of the image
 public:
 	Object() : height(0), width(0), angle(0) {}
 	Object(const String& f, const Vector2f& new_position,
@@ -55,4 +57,6 @@ public:
 
 	//void Rotate(const float& new_angle);
 	virtual void Draw(RenderWindow& window) const;
+	virtual void DrawSprites(SpriteBatch& batch) const; //batched layer of sprites
+	virtual void DrawLabels(TextBatch& batch) const; //texts drawn over the sprites
 };
\ No newline at end of file
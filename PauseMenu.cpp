@@ -61,9 +61,16 @@ bool PauseMenu(RenderWindow& window, bool& isPaused, bool& Restart, View& view)
     }
 
     buttons[selected_button].SetSelected(1);
+    SpriteBatch sprites;
+    TextBatch labels; //and one for all the texts
     for (int i = 0; i < buttons.size(); ++i) {
-        buttons[i].Draw(window);
+        buttons[i].DrawSprites(sprites);
     }
+    sprites.Draw(window);
+    for (int i = 0; i < buttons.size(); ++i) {
+        buttons[i].DrawLabels(labels);
+    }
+    labels.Draw(window);
 
     //view.setCenter(sf::Vector2f(window_x() / 2, window_y() / 2));
     view.setSize(sf::Vector2f(window_x(), window_y()));
@@ -0,0 +1,115 @@
+#include "PlanetPreview.h"
+#include "ThreadPool.h"
+#include <algorithm>
+
+bool PlanetParams::operator == (const PlanetParams& p) const {
+	return file == p.file && rough == p.rough && snow_coverage == p.snow_coverage &&
+		probability == p.probability && max_angle == p.max_angle && gravity == p.gravity &&
+		air_density == p.air_density && seed == p.seed && generator == p.generator;
+}
+bool PlanetParams::operator != (const PlanetParams& p) const { return !(*this == p); }
+
+PlanetPreview::PlanetPreview(const FloatRect& a, const int& n) : area(a), points(n) {
+	frame.setPosition(area.left, area.top);
+	frame.setSize({ area.width, area.height });
+	frame.setFillColor(Color(0x00000080));
+	frame.setOutlineColor(Color(0x0000f080));
+	frame.setOutlineThickness(2);
+}
+
+PlanetPreview::~PlanetPreview() {
+	if (job) {
+		job->cancel = true; //the worker keeps its own reference and finishes on its own
+	}
+}
+
+void PlanetPreview::Run(std::shared_ptr<Job> job, FloatRect area, int points) {
+	const PlanetParams& p = job->params;
+	std::unique_ptr<Surface> surface(new Surface(p.file, p.rough, p.snow_coverage, p.probability,
+		p.max_angle, p.gravity, p.air_density, p.seed, p.generator, &job->cancel));
+	VertexArray silhouette(TrianglesStrip);
+	int n = surface->GetSampleCount();
+	if (!surface->Cancelled() && n > 1) {
+		float top = surface->GetSampleHeight(0), bottom = top;
+		for (int i = 0; i < n; ++i) {
+			top = std::min(top, surface->GetSampleHeight(i));
+			bottom = std::max(bottom, surface->GetSampleHeight(i));
+		}
+		float scale = 0.8f * area.height / std::max(bottom - top, 1.f); //10% free above and below
+		for (int k = 0; k <= points; ++k) { //every (n / points)-th sample
+			int i = k * (n - 1) / points;
+			float x = area.left + k * area.width / points;
+			Color color = surface->MaterialColor(surface->GetMaterial(i));
+			silhouette.append(Vertex({ x, area.top + 0.1f * area.height + (surface->GetSampleHeight(i) - top) * scale }, color));
+			silhouette.append(Vertex({ x, area.top + area.height }, color));
+		}
+	}
+	std::lock_guard<std::mutex> lock(job->mutex);
+	if (!surface->Cancelled()) {
+		job->surface = std::move(surface);
+		job->silhouette = silhouette;
+	}
+	job->done = true;
+	job->finished.notify_all();
+}
+
+void PlanetPreview::Request(const PlanetParams& params) {
+	if (job && job->params == params) {
+		return;
+	}
+	if (job) {
+		job->cancel = true;
+	}
+	job = std::make_shared<Job>();
+	job->params = params;
+	shown = false;
+	std::shared_ptr<Job> j = job;
+	FloatRect a = area;
+	int n = points;
+	Workers().Push([j, a, n]() { Run(j, a, n); });
+}
+
+void PlanetPreview::Update() {
+	frame.setOutlineColor(IsBuilding() ? Color(0x0000f080) : Color(0x0000f0ff)); //dim while building
+	if (!job || shown) {
+		return;
+	}
+	std::lock_guard<std::mutex> lock(job->mutex);
+	if (job->done) {
+		silhouette = job->silhouette;
+		shown = true;
+	}
+}
+
+bool PlanetPreview::IsBuilding() const {
+	return job && !shown;
+}
+
+bool PlanetPreview::IsDone(const PlanetParams& p) const {
+	if (!job || job->params != p) {
+		return false;
+	}
+	std::lock_guard<std::mutex> lock(job->mutex);
+	return job->done;
+}
+
+void PlanetPreview::Draw(RenderWindow& window) const {
+	window.draw(frame);
+	window.draw(silhouette); //the previous planet stays until the new one is ready
+}
+
+Surface PlanetPreview::Take(const PlanetParams& p) {
+	if (job && job->params == p) {
+		std::unique_lock<std::mutex> lock(job->mutex);
+		job->finished.wait(lock, [this] { return job->done; });
+		if (job->surface) {
+			std::unique_ptr<Surface> surface = std::move(job->surface);
+			lock.unlock();
+			job.reset();
+			surface->Finish(); //the cache file and GL uploads, on this thread
+			return std::move(*surface);
+		}
+	}
+	return Surface(p.file, p.rough, p.snow_coverage, p.probability, p.max_angle, p.gravity,
+		p.air_density, p.seed, p.generator);
+}
\ No newline at end of file
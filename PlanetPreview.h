@@ -0,0 +1,60 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include "Surface.h"
+
+using namespace sf;
+
+struct PlanetParams {
+	String file;
+	int rough;
+	int snow_coverage;
+	std::map<Hole, int> probability;
+	int max_angle;
+	int gravity;
+	int air_density;
+	unsigned int seed;
+	Generator generator;
+
+	bool operator == (const PlanetParams& p) const;
+	bool operator != (const PlanetParams& p) const;
+};
+
+//Builds the planet of the current settings on a worker and shows its silhouette.
+//A new request cancels the running build, so the last settings always win, and the
+//finished build is the planet itself, so "Next" usually finds it ready.
+class PlanetPreview {
+private:
+	struct Job {
+		PlanetParams params;
+		std::atomic<bool> cancel{ false };
+		bool done = false;
+		std::unique_ptr<Surface> surface; //nullptr if cancelled
+		VertexArray silhouette;
+		std::mutex mutex;
+		std::condition_variable finished;
+	};
+	std::shared_ptr<Job> job;
+	bool shown = false; //silhouette of job is in silhouette
+	FloatRect area;
+	int points; //silhouette resolution
+	VertexArray silhouette;
+	RectangleShape frame;
+
+	static void Run(std::shared_ptr<Job> job, FloatRect area, int points);
+public:
+	PlanetPreview(const FloatRect& area, const int& points);
+	PlanetPreview(const PlanetPreview&) = delete;
+	PlanetPreview& operator = (const PlanetPreview&) = delete;
+	~PlanetPreview();
+
+	void Request(const PlanetParams& params); //no-op if these params are already built or building
+	void Update(); //takes a finished silhouette, call every frame
+	bool IsBuilding() const;
+	bool IsDone(const PlanetParams& params) const; //Take(params) won't wait
+	void Draw(RenderWindow& window) const;
+	//the planet of params ready to draw; waits for the running build, builds it here if there is none
+	Surface Take(const PlanetParams& params);
+};
\ No newline at end of file
@@ -1,11 +1,11 @@
 #include "Menu.h"
+#include "PlanetPreview.h"
+#include "LoadingScreen.h"
 
 Surface PlanetSettings(RenderWindow& window, bool& if_Menu) {
-    Texture bg_texture;
-    bg_texture.loadFromFile("images/background.png");
-    bg_texture.setRepeated(true);
+    std::shared_ptr<const Texture> bg_texture = LoadTexture("images/background.png", false, true);
     Sprite bg_sprite;
-    bg_sprite.setTexture(bg_texture);
+    bg_sprite.setTexture(*bg_texture);
     bg_sprite.setTextureRect({ 0, 0, int(window_x()), int(window_y()) });
 
     Object title("PlanetSettings.png", { 0, 0 }, 600, 100, 0);
@@ -32,11 +32,42 @@ Surface PlanetSettings(RenderWindow& window, bool& if_Menu) {
     buttons.push_back(Button("Random", { x_mid, float(window_y() - 130) }));
     buttons.push_back(Button("Next", { float(window_x() - 450), float(window_y() - 130) }));
 
+    LoadingScreen loading("Building the planet");
+    loading.Start("Textures", [] { Surface::Prefetch("surface.png"); });
+
+    Generator generator = Generator::WALK;
+    unsigned int seed = rand();
+    auto params = [&]() {
+        PlanetParams p;
+        p.file = "surface.png"; //prefetched above
+        p.probability = {   { Hole::LAKE, items[0].GetValue() },
+                            { Hole::EMPTY_U, items[1].GetValue() / 2 },
+                            { Hole::EMPTY_V, items[1].GetValue() / 2 },
+                            { Hole::ICE, items[3].GetValue() },
+                            { Hole::METEORITE, items[4].GetValue() },
+        };
+        p.rough = 10;
+        p.max_angle = items[5].GetValue() / 100.0 * 70; //slopes
+        p.snow_coverage = items[6].GetValue();
+        p.gravity = items[2].GetValue();
+        p.air_density = items[7].GetValue();
+        p.seed = seed;
+        p.generator = generator;
+        return p;
+    };
+    //between the title and the first row of items
+    PlanetPreview preview({ 100, title.GetPosition().y + title.GetHeight() + 5, window_x() - 200.f, 70 }, (window_x() - 200) / 4);
+    SdfText planet_info("", 20); //in the corner of the preview, the seed reproduces the planet
+    planet_info.SetPosition({ 110, title.GetPosition().y + title.GetHeight() + 10 });
+    planet_info.SetColor(Color(0x0000f0ff));
+
     int obj_num = items.size() + buttons.size();
     bool selecting = 1;
     int selected = 0; //selected item or button
 
     View view;
+    SpriteBatch sprites; //one draw call for the whole screen with the atlas
+    TextBatch labels; //and one for all the texts
     while (selecting && window.isOpen()) {
 
         view.setCenter(sf::Vector2f(window_x() / 2, window_y() / 2));
@@ -69,6 +100,9 @@ Surface PlanetSettings(RenderWindow& window, bool& if_Menu) {
                     if_Menu = 1;
                     selecting = 0;
                 }
+                if (event.key.code == Keyboard::G) { //terrain generator, shown with the seed
+                    generator = generator == Generator::WALK ? Generator::NOISE : Generator::WALK;
+                }
                 if (event.key.code == Keyboard::W || event.key.code == Keyboard::Up) {
                     selected = (selected - 1 + obj_num) % obj_num;
                 }
@@ -98,6 +132,7 @@ Surface PlanetSettings(RenderWindow& window, bool& if_Menu) {
                             for (auto& item : items) {
                                 item.SetValue(rand() % 21 * 5);
                             }
+                            seed = rand();
                             break;
                         case 2: //next
                             if_Menu = 0;
@@ -134,29 +169,41 @@ Surface PlanetSettings(RenderWindow& window, bool& if_Menu) {
             items[selected].SetSelected(1);
         }
 
+        preview.Request(params()); //restarts the build only if a value changed
+        preview.Update();
+        planet_info.SetString("Seed: " + std::to_string(seed) + "    Terrain: " +
+            (generator == Generator::WALK ? "walk" : "noise") + " (G to change)"); //laid out only on a change
+
         window.clear();
         window.draw(bg_sprite);
+        preview.Draw(window);
+        sprites.Clear();
+        labels.Clear();
         for (auto& item : items) {
-            item.Draw(window);
+            item.DrawSprites(sprites);
         }
         for (auto& button : buttons) {
-            button.Draw(window);
+            button.DrawSprites(sprites);
         }
-        title.Draw(window);
+        title.DrawSprites(sprites);
+        sprites.Draw(window);
+        for (auto& item : items) {
+            item.DrawLabels(labels);
+        }
+        for (auto& button : buttons) {
+            button.DrawLabels(labels);
+        }
+        labels.Add(planet_info);
+        labels.Draw(window);
 
         window.display();
     }
 
-    std::map<Hole, int> probability = {     { Hole::LAKE, items[0].GetValue() },
-                                            { Hole::EMPTY_U, items[1].GetValue()/2  },
-                                            { Hole::EMPTY_V, items[1].GetValue()/2 },
-                                            { Hole::ICE, items[3].GetValue() },
-                                            { Hole::METEORITE, items[4].GetValue() },
-    };
-    int rough = 10;
-    int max_angle = items[5].GetValue() / 100.0 * 70; //slopes
-    int snow_coverage = items[6].GetValue();
-    int gravity = items[2].GetValue();
-    int air_density = items[7].GetValue();
-    return Surface("surface.png", rough, snow_coverage, probability, max_angle, gravity, air_density);
+    PlanetParams chosen = params();
+    if (!if_Menu) { //the build goes on, the window keeps drawing
+        preview.Request(chosen);
+        loading.Wait("Terrain", [&preview, &chosen] { return preview.IsDone(chosen); });
+        loading.Run(window);
+    }
+    return preview.Take(chosen); //only the GPU upload is left
 }
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include "Random.h"
+
+static uint64_t splitmix64(uint64_t x) {
+	x += 0x9e3779b97f4a7c15ULL;
+	x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+	return x ^ (x >> 31);
+}
+
+Random::Random() : key(MakeKey(0, 0, Stream::TERRAIN)) {}
+Random::Random(uint32_t seed, uint32_t chunk, Stream stream) : key(MakeKey(seed, chunk, stream)) {}
+
+uint64_t Random::MakeKey(uint32_t seed, uint32_t chunk, Stream stream) {
+	uint64_t k = splitmix64((uint64_t(seed) << 32) | chunk);
+	k = splitmix64(k ^ uint64_t(stream));
+	return k | 1; //Squares needs an odd key
+}
+
+uint32_t Random::Squares(uint64_t ctr, uint64_t key) {
+	uint64_t x, y, z;
+	y = x = ctr * key;
+	z = y + key;
+	x = x * x + y; x = (x >> 32) | (x << 32);
+	x = x * x + z; x = (x >> 32) | (x << 32);
+	x = x * x + y; x = (x >> 32) | (x << 32);
+	return uint32_t((x * x + z) >> 32);
+}
+
+uint32_t Random::At(uint64_t ctr) const { return Squares(ctr, key); }
+uint32_t Random::Next() { return Squares(counter++, key); }
+int Random::operator()(int n) { return Bounded(Next(), n); }
+float Random::Uniform() { return (Next() >> 8) * (1.f / 16777216.f); }
+
+void Random::Fill(uint32_t* out, size_t n) {
+	//no dependency between iterations, the compiler is free to vectorize it
+	const uint64_t first = counter;
+	for (size_t i = 0; i < n; ++i) {
+		out[i] = Squares(first + i, key);
+	}
+	counter += n;
+}
+void Random::Fill(std::vector<uint32_t>& out) { Fill(out.data(), out.size()); }
+
+uint64_t Random::GetCounter() const { return counter; }
+void Random::Seek(const uint64_t& new_counter) { counter = new_counter; }
+
+int Bounded(uint32_t r, int n) {
+	if (n <= 0) { return 0; }
+	return int((uint64_t(r) * uint32_t(n)) >> 32);
+}
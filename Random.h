@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+//independent random streams of one planet
+enum class Stream : uint32_t {
+	TERRAIN,
+	SLOPE,
+	HOLE,
+	SNOW,
+	COLOR,
+	SPACE,
+	NOISE //one key per noise layer
+};
+
+//Counter-based generator (Widynski "Squares"): the n-th number of a stream is a pure
+//function of (key, n), so any chunk can be generated on any thread in any order
+//and still give bit-identical results.
+class Random {
+private:
+	uint64_t key;
+	uint64_t counter = 0;
+public:
+	Random();
+	Random(uint32_t seed, uint32_t chunk, Stream stream);
+
+	static uint64_t MakeKey(uint32_t seed, uint32_t chunk, Stream stream);
+	static uint32_t Squares(uint64_t ctr, uint64_t key);
+
+	uint32_t At(uint64_t ctr) const;
+	uint32_t Next();
+	int operator()(int n); //[0, n), replacement for rand() % n
+	float Uniform(); //[0, 1)
+
+	void Fill(uint32_t* out, size_t n); //n next numbers, counter += n
+	void Fill(std::vector<uint32_t>& out);
+
+	uint64_t GetCounter() const;
+	void Seek(const uint64_t& new_counter);
+};
+
+int Bounded(uint32_t r, int n); //maps a raw 32-bit number to [0, n)
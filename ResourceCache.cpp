@@ -0,0 +1,152 @@
+#include "ResourceCache.h"
+#include "AssetPack.h"
+#include <map>
+#include <mutex>
+#include <functional>
+#include <set>
+#include <condition_variable>
+
+//Holds the assets weakly: one stays loaded while a handle to it exists and is loaded
+//again after the last one is gone. Loads run outside the lock, a second request for
+//the same key waits for the first one instead of loading it twice.
+template <typename T>
+class Cache {
+private:
+	struct Entry {
+		std::weak_ptr<const T> item;
+		bool loading = false;
+	};
+	std::map<std::string, Entry> items; //entries are never erased, references stay valid
+	std::mutex mutex;
+	std::condition_variable loaded;
+public:
+	std::shared_ptr<const T> Get(const std::string& key, const std::function<void(T&)>& load) {
+		std::unique_lock<std::mutex> lock(mutex);
+		Entry& entry = items[key];
+		loaded.wait(lock, [&entry] { return !entry.loading; });
+		if (std::shared_ptr<const T> item = entry.item.lock()) {
+			return item;
+		}
+		entry.loading = true;
+		lock.unlock();
+		auto item = std::make_shared<T>(); //created in place, SFML resources are expensive to copy
+		load(*item);
+		lock.lock();
+		entry.item = item;
+		entry.loading = false;
+		loaded.notify_all();
+		return item;
+	}
+};
+
+static std::map<std::string, std::shared_ptr<const Image>> prefetched;
+static std::set<std::string> prefetching;
+static std::set<std::string> taken; //uploaded already, not prefetched again (a reload after release decodes in place)
+static std::mutex prefetch_mutex;
+static std::condition_variable prefetch_done;
+
+static std::shared_ptr<const Image> Decode(const std::string& path) {
+	auto image = std::make_shared<Image>();
+	const AssetEntry* packed = Assets().Find(path, AssetType::IMAGE);
+	if (packed) {
+		image->create(packed->a, packed->b, static_cast<const Uint8*>(Assets().Data(*packed)));
+	}
+	else {
+		image->loadFromFile(path);
+	}
+	return image;
+}
+
+void PrefetchImage(const std::string& path) {
+	if (Assets().Find(path, AssetType::IMAGE)) {
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(prefetch_mutex);
+		if (prefetched.count(path) || prefetching.count(path) || taken.count(path)) {
+			return;
+		}
+		prefetching.insert(path);
+	}
+	std::shared_ptr<const Image> image = Decode(path);
+	{
+		std::lock_guard<std::mutex> lock(prefetch_mutex);
+		prefetching.erase(path);
+		prefetched[path] = image;
+	}
+	prefetch_done.notify_all();
+}
+
+std::shared_ptr<const Image> DecodeImage(const std::string& path, bool keep) {
+	{
+		std::unique_lock<std::mutex> lock(prefetch_mutex);
+		prefetch_done.wait(lock, [&path] { return !prefetching.count(path); }); //a worker is on it already
+		if (!keep) {
+			taken.insert(path);
+		}
+		auto it = prefetched.find(path);
+		if (it != prefetched.end()) {
+			std::shared_ptr<const Image> image = it->second;
+			if (!keep) {
+				prefetched.erase(it);
+			}
+			return image;
+		}
+	}
+	return Decode(path);
+}
+
+void ForgetImage(const std::string& path) {
+	std::lock_guard<std::mutex> lock(prefetch_mutex);
+	prefetched.erase(path);
+	taken.insert(path);
+}
+
+std::shared_ptr<const Texture> LoadTexture(const std::string& path, bool mask_black, bool repeated) {
+	static Cache<Texture> cache;
+	std::string key = path + (mask_black ? "|mask" : "") + (repeated ? "|repeat" : "");
+	return cache.Get(key, [&](Texture& texture) {
+		const AssetEntry* packed = Assets().Find(path, AssetType::IMAGE);
+		if (packed && !mask_black) { //pixels straight from the mapped pack
+			if (texture.create(packed->a, packed->b)) {
+				texture.update(static_cast<const Uint8*>(Assets().Data(*packed)));
+			}
+		}
+		else if (mask_black) {
+			Image image = *DecodeImage(path);
+			image.createMaskFromColor(Color(0, 0, 0));
+			texture.loadFromImage(image);
+		}
+		else {
+			texture.loadFromImage(*DecodeImage(path));
+		}
+		texture.setRepeated(repeated);
+	});
+}
+
+std::shared_ptr<const SoundBuffer> LoadSound(const std::string& path) {
+	static Cache<SoundBuffer> cache;
+	return cache.Get(path, [&](SoundBuffer& buffer) {
+		const AssetEntry* packed = Assets().Find(path, AssetType::SOUND);
+		if (packed) {
+			buffer.loadFromSamples(static_cast<const Int16*>(Assets().Data(*packed)), packed->size / sizeof(Int16),
+				packed->a, packed->b);
+		}
+		else {
+			buffer.loadFromFile(path);
+		}
+	});
+}
+
+std::shared_ptr<const Font> LoadFont(const std::string& path) {
+	static Cache<Font> cache;
+	return cache.Get(path, [&](Font& font) {
+		const AssetEntry* packed = Assets().Find(path, AssetType::FONT);
+		if (packed) { //the mapping outlives every font
+			font.loadFromMemory(Assets().Data(*packed), size_t(packed->size));
+		}
+		else {
+			font.loadFromFile(path);
+		}
+	});
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <SFML/Audio.hpp>
+#include <memory>
+#include <string>
+
+using namespace sf;
+
+//Process-wide cache of decoded assets keyed by path (and texture options).
+//An asset stays loaded while a handle to it is held; users share it through the handles,
+//and it is freed with the last one.
+//Thread-safe, but textures still have to be loaded on a thread with a GL context.
+std::shared_ptr<const Texture> LoadTexture(const std::string& path, bool mask_black = false, bool repeated = false);
+std::shared_ptr<const SoundBuffer> LoadSound(const std::string& path);
+std::shared_ptr<const Font> LoadFont(const std::string& path);
+
+
+//CPU side of the textures. Decoding runs on any thread, only the upload needs the GL one:
+//PrefetchImage decodes ahead (on a worker), so LoadTexture and the atlas find the pixels
+//ready and only upload them. Images of the asset pack are decoded already: DecodeImage
+//copies their pixels out of the mapping, LoadTexture uploads them straight from it.
+void PrefetchImage(const std::string& path);
+//prefetched or decoded now, empty if it can't be loaded; keep leaves the prefetched copy for the next user
+std::shared_ptr<const Image> DecodeImage(const std::string& path, bool keep = false);
+void ForgetImage(const std::string& path); //drops a kept prefetched copy
@@ -143,16 +143,52 @@ void RigidBody::DrawMassPosition(RenderWindow& window) const {
 }
 
 void RigidBody::DrawBodyWay(RenderWindow& window) {
-	way.setPrimitiveType(LinesStrip);
-	way.append(Vertex(Vector2f(GetPosition().x + diag * cos(RAD * GetAngle() + b),
-		GetPosition().y + diag * sin(RAD * GetAngle() + b)),
-		Color::Red
-	));
-	window.draw(way);
+	Vector2f p(GetPosition().x + diag * cos(RAD * GetAngle() + b),
+		GetPosition().y + diag * sin(RAD * GetAngle() + b));
+	if (way.empty()) {
+		way.resize(WAY_CAPACITY + 1);
+	}
+	bool add = way_head == 0 && !way_full; //the first point
+	if (!add) {
+		const Vector2f& last = way[(way_head + WAY_CAPACITY - 1) % WAY_CAPACITY].position;
+		Vector2f step = p - last;
+		float length = sqrt(step.x * step.x + step.y * step.y);
+		if (length >= WAY_MIN_STEP) {
+			add = true;
+		}
+		else if (length >= 1 && (way_direction.x != 0 || way_direction.y != 0)) { //a turn on the spot
+			float cos_turn = (step.x * way_direction.x + step.y * way_direction.y) / length;
+			add = cos_turn < cos(RAD * WAY_MIN_TURN);
+		}
+		if (add) {
+			way_direction = step / length;
+		}
+	}
+	if (add) {
+		way[way_head] = Vertex(p, Color::Red);
+		if (way_head == 0) {
+			way[WAY_CAPACITY] = way[0];
+		}
+		way_head = (way_head + 1) % WAY_CAPACITY;
+		way_full = way_full || way_head == 0;
+	}
+	if (way_full && way_head > 0) { //oldest to the end, then the newest
+		window.draw(&way[way_head], WAY_CAPACITY + 1 - way_head, LinesStrip);
+		window.draw(&way[0], way_head, LinesStrip);
+	}
+	else if (way_full) { //in order already, the mirror slot would join the newest to the oldest
+		window.draw(&way[0], WAY_CAPACITY, LinesStrip);
+	}
+	else {
+		window.draw(&way[0], way_head, LinesStrip);
+	}
 }
 
 void RigidBody::DeleteBodyWay(RenderWindow& window) {
 	way.clear();
+	way_head = 0;
+	way_full = false;
+	way_direction = Vector2f(0, 0);
 }
 
 void RigidBody::DrawForce(RenderWindow& window, const Force& force) const {
@@ -234,17 +270,14 @@ int RigidBody::GetFlyStatus() const { return fly_status; }
 void RigidBody::SetFlyStatus(const int& new_status) { fly_status = new_status; }
 
 bool RigidBody::LandingCheck(const Surface& s) {
-	long mid_iter = s.Get_iter_0() + 2 * GetCenterPosition().x / s.Get_spacing();
-	long start = mid_iter - sqrt(pow(height, 2) + pow(width, 2)) / (2 * s.Get_spacing());
-	long end = mid_iter + sqrt(pow(height, 2) + pow(width, 2)) / (2 * s.Get_spacing());
-	start = (start / 2) * 2;
-	end = (end / 2) * 2;
-	Line surface_line(Point(s.GetVertex(start).position.x, s.GetVertex(start).position.y),
-		Point(s.GetVertex(end).position.x, s.GetVertex(end).position.y));
+	TerrainSampler terrain = s.Sampler();
+	float x = GetCenterPosition().x;
+	float half = sqrt(pow(height, 2) + pow(width, 2)) / 4; //ground under the ship
+	float rise = terrain.Height(x + half) - terrain.Height(x - half);
 
 	int ship_angle = GetAngle();
 	ship_angle %= 360;
-	int surface_angle = surface_line.GetAngle();
+	int surface_angle = atan(rise / (2 * half)) / RAD;
 
 	timer.restart();
 
@@ -8,9 +8,11 @@
 #include <string>
 #include "Geom/Geometric.h"
 
-#define MAX_ANGLE 20
 #define MAX_ANGLE_BETWEEN 5
 #define MAX_VELOCITY 100
+#define WAY_CAPACITY 4096 //points of the trail, the oldest are overwritten
+#define WAY_MIN_STEP 4 //px the body moves before the trail gets a point
+#define WAY_MIN_TURN 5 //degrees the path turns before the trail gets a point
 #define MAX_ANGLE_VELOCITY 50
 
 static Clock timer;
@@ -65,7 +67,12 @@ protected:
 	float b = atan((GetHeight() * GetMassPosition().y) / (GetWidth() * GetMassPosition().x));
 	//the angle between the horizon and the segment connecting the upper-left corner and the center of mass
 
-	VertexArray way;
+	//Trail of the body: a ring of WAY_CAPACITY + 1 points, the last slot mirrors slot 0,
+	//so the full ring is drawn as two contiguous strips: [way_head, end] and [0, way_head).
+	std::vector<Vertex> way;
+	size_t way_head = 0; //next slot to write, the oldest point once the ring is full
+	bool way_full = false;
+	Vector2f way_direction; //of the last step of the trail
 	std::vector<Point> collision_vertex;
 
 	std::map<String,Force> forces;
@@ -119,6 +126,7 @@ public:
 
 	bool LandingCheck(const Surface& s);
 private:
+	void DetectCollision(const Surface& s, RenderWindow* window); //window - nullptr, or to draw the search on
 	bool IntercectionWithSurface(const Point& p, const Line& surface_line, const Surface& s) const;
 	bool IntercectionWithSurface(const Point& p, const Line& surface_line, const Surface& s, RenderWindow& window) const;
 	
@@ -0,0 +1,152 @@
+#include "SdfFont.h"
+#include "ResourceCache.h"
+#include "ThreadPool.h"
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+static const char* SDF_SHADER =
+	"uniform sampler2D texture;"
+	"void main() {"
+	"	float d = texture2D(texture, gl_TexCoord[0].xy).a;"
+	"	float w = max(fwidth(d) * 0.7, 0.001);" //about a screen pixel at any scale
+	"	gl_FragColor = vec4(gl_Color.rgb, gl_Color.a * smoothstep(0.5 - w, 0.5 + w, d));"
+	"}";
+
+SdfFont::SdfFont(std::shared_ptr<const Font> f, const unsigned int& size, const int& s)
+	: font(f), base_size(size), spread(s) {
+	Bake();
+}
+
+//distance of every pixel of a glyph (with the spread around it) to the nearest pixel of
+//the other side of the edge, searched outwards so most pixels stop after a few steps
+static void DistanceField(const Image& page, const IntRect& glyph, const int& spread,
+	const std::vector<Vector2i>& offsets, std::vector<float>& out) {
+	int w = glyph.width + 2 * spread, h = glyph.height + 2 * spread;
+	std::vector<char> mask(size_t(w) * h, 0);
+	for (int y = 0; y < glyph.height; ++y) {
+		for (int x = 0; x < glyph.width; ++x) {
+			mask[size_t(y + spread) * w + x + spread] = page.getPixel(glyph.left + x, glyph.top + y).a >= 128;
+		}
+	}
+	auto inside = [&](int x, int y) { //coordinates of the field
+		return x >= 0 && y >= 0 && x < w && y < h && mask[size_t(y) * w + x];
+	};
+	out.assign(size_t(w) * h, 0);
+	for (int y = 0; y < h; ++y) {
+		for (int x = 0; x < w; ++x) {
+			bool in = inside(x, y);
+			float d = float(spread);
+			for (const Vector2i& o : offsets) {
+				if (inside(x + o.x, y + o.y) != in) {
+					d = std::min(std::sqrt(float(o.x * o.x + o.y * o.y)) - 0.5f, float(spread)); //edge is between the pixels
+					break;
+				}
+			}
+			out[size_t(y) * w + x] = 0.5f + (in ? d : -d) / (2 * spread); //0.5 on the edge
+		}
+	}
+}
+
+void SdfFont::Bake() {
+	struct Baked {
+		Uint32 c;
+		bool bold;
+		sf::Glyph glyph;
+		std::vector<float> field;
+		IntRect place;
+	};
+	std::vector<Baked> baked;
+	for (int bold = 0; bold < 2; ++bold) {
+		for (Uint32 c = 32; c < 127; ++c) {
+			baked.push_back(Baked{ c, bold != 0, font->getGlyph(c, base_size, bold != 0), std::vector<float>(), IntRect() });
+		}
+	}
+	Image page = font->getTexture(base_size).copyToImage(); //once, every glyph is on it now
+
+	std::vector<Vector2i> offsets; //within the spread, nearest first
+	for (int y = -spread; y <= spread; ++y) {
+		for (int x = -spread; x <= spread; ++x) {
+			if ((x || y) && x * x + y * y <= spread * spread) {
+				offsets.push_back({ x, y });
+			}
+		}
+	}
+	std::sort(offsets.begin(), offsets.end(), [](const Vector2i& a, const Vector2i& b) {
+		return a.x * a.x + a.y * a.y < b.x * b.x + b.y * b.y;
+	});
+	Workers().ParallelFor(0, int(baked.size()), 8, [&](int first, int last) {
+		for (int i = first; i < last; ++i) {
+			DistanceField(page, baked[i].glyph.textureRect, spread, offsets, baked[i].field);
+		}
+	});
+
+	//shelves of a 1024 wide texture
+	int atlas_width = 1024, x = 0, y = 0, shelf = 0;
+	for (Baked& b : baked) {
+		int w = b.glyph.textureRect.width + 2 * spread, h = b.glyph.textureRect.height + 2 * spread;
+		if (x + w > atlas_width) {
+			x = 0;
+			y += shelf + 1;
+			shelf = 0;
+		}
+		b.place = IntRect(x, y, w, h);
+		x += w + 1;
+		shelf = std::max(shelf, h);
+	}
+	shader_ready = Shader::isAvailable() && shader.loadFromMemory(SDF_SHADER, Shader::Fragment);
+	if (shader_ready) {
+		shader.setUniform("texture", Shader::CurrentTexture);
+	}
+	Image atlas;
+	atlas.create(atlas_width, y + shelf + 1, Color(255, 255, 255, 0)); //white, vertex colors tint it
+	for (const Baked& b : baked) {
+		for (int j = 0; j < b.place.height; ++j) {
+			for (int i = 0; i < b.place.width; ++i) {
+				float d = b.field[size_t(j) * b.place.width + i];
+				if (!shader_ready) { //the shader's edge, one base pixel wide
+					d = std::min(std::max((d - 0.5f) * 2 * spread + 0.5f, 0.f), 1.f);
+				}
+				atlas.setPixel(b.place.left + i, b.place.top + j, Color(255, 255, 255, Uint8(std::min(std::max(d, 0.f), 1.f) * 255 + 0.5f)));
+			}
+		}
+		SdfGlyph g;
+		g.bounds = b.glyph.bounds;
+		g.rect = FloatRect(b.place);
+		g.advance = b.glyph.advance;
+		glyphs[b.bold][b.c] = g;
+	}
+	texture.loadFromImage(atlas);
+	texture.setSmooth(true); //the field is interpolated
+	texture.generateMipmap(); //small text without the shader
+}
+
+const SdfGlyph* SdfFont::Glyph(const Uint32& c, const bool& bold) const {
+	auto it = glyphs[bold].find(c);
+	return it == glyphs[bold].end() ? nullptr : &it->second;
+}
+
+float SdfFont::Kerning(const Uint32& first, const Uint32& second, const unsigned int& size) const {
+	return font->getKerning(first, second, base_size) * Scale(size);
+}
+
+float SdfFont::Scale(const unsigned int& size) const {
+	return float(size) / base_size;
+}
+
+float SdfFont::Spread() const {
+	return float(spread);
+}
+
+const Texture& SdfFont::GetTexture() const {
+	return texture;
+}
+
+const Shader* SdfFont::GetShader() const {
+	return shader_ready ? &shader : nullptr;
+}
+
+SdfFont& UiFont() {
+	static SdfFont font(LoadFont("fonts/FRAHV.ttf"), 48, 6);
+	return font;
+}
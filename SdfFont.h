@@ -0,0 +1,42 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <map>
+
+using namespace sf;
+
+struct SdfGlyph {
+	FloatRect bounds; //of the glyph at the base size, from the pen on the baseline
+	FloatRect rect; //on the atlas texture, with the spread around the glyph
+	float advance;
+};
+
+//Signed distance field of a font, baked once from one size into one texture.
+//Text of any size and style is scaled from it, so all UI text shares a texture and
+//batches into one draw call. The edge is found by a small shader; without shaders
+//the field is turned into plain coverage on the CPU at bake time.
+class SdfFont {
+private:
+	std::shared_ptr<const Font> font;
+	unsigned int base_size;
+	int spread; //pixels of distance stored around each glyph
+	std::map<Uint32, SdfGlyph> glyphs[2]; //regular, bold
+	Texture texture;
+	Shader shader;
+	bool shader_ready = false;
+
+	void Bake();
+public:
+	SdfFont(std::shared_ptr<const Font> font, const unsigned int& base_size, const int& spread);
+	SdfFont(const SdfFont&) = delete;
+	SdfFont& operator = (const SdfFont&) = delete;
+
+	const SdfGlyph* Glyph(const Uint32& c, const bool& bold) const; //nullptr if not baked (only ASCII is)
+	float Kerning(const Uint32& first, const Uint32& second, const unsigned int& size) const;
+	float Scale(const unsigned int& size) const; //from the base size
+	float Spread() const;
+	const Texture& GetTexture() const;
+	const Shader* GetShader() const; //nullptr if shaders are unavailable
+};
+
+SdfFont& UiFont(); //FRAHV.ttf, baked on the first use (render thread)
@@ -0,0 +1,117 @@
+#include "SdfText.h"
+#include "TextBatch.h"
+#include <algorithm>
+
+SdfText::SdfText(const String& s, const unsigned int& sz, const bool& b) : string(s), size(sz), bold(b) {
+	LayOut();
+}
+
+void SdfText::LayOut() {
+	const SdfFont& font = UiFont();
+	float scale = font.Scale(size);
+	float pad = font.Spread(); //the quads cover the field around the glyphs
+	quads.clear();
+	float x = 0, y = float(size); //baseline, as sf::Text
+	float min_x = 0, min_y = 0, max_x = 0, max_y = 0;
+	bool first = true;
+	Uint32 previous = 0;
+	for (size_t i = 0; i < string.getSize(); ++i) {
+		Uint32 c = string[i];
+		x += font.Kerning(previous, c, size);
+		previous = c;
+		const SdfGlyph* glyph = font.Glyph(c, bold);
+		if (!glyph) {
+			continue;
+		}
+		if (c != ' ' && c != '\t') {
+			float left = x + glyph->bounds.left * scale, top = y + glyph->bounds.top * scale;
+			float right = left + glyph->bounds.width * scale, bottom = top + glyph->bounds.height * scale;
+			if (first) {
+				min_x = left;
+				min_y = top;
+				max_x = right;
+				max_y = bottom;
+				first = false;
+			}
+			min_x = std::min(min_x, left);
+			min_y = std::min(min_y, top);
+			max_x = std::max(max_x, right);
+			max_y = std::max(max_y, bottom);
+			left -= pad * scale;
+			top -= pad * scale;
+			right += pad * scale;
+			bottom += pad * scale;
+			const FloatRect& r = glyph->rect;
+			Vertex quad[4] = {
+				Vertex({ left, top }, color, { r.left, r.top }),
+				Vertex({ right, top }, color, { r.left + r.width, r.top }),
+				Vertex({ right, bottom }, color, { r.left + r.width, r.top + r.height }),
+				Vertex({ left, bottom }, color, { r.left, r.top + r.height })
+			};
+			static const int order[6] = { 0, 1, 2, 0, 2, 3 };
+			for (int k : order) {
+				quads.push_back(quad[k]);
+			}
+		}
+		x += glyph->advance * scale;
+	}
+	bounds = FloatRect(min_x, min_y, max_x - min_x, max_y - min_y);
+}
+
+void SdfText::SetString(const String& s) {
+	if (s != string) {
+		string = s;
+		LayOut();
+	}
+}
+
+void SdfText::SetSize(const unsigned int& s) {
+	if (s != size) {
+		size = s;
+		LayOut();
+	}
+}
+
+void SdfText::SetBold(const bool& b) {
+	if (b != bold) {
+		bold = b;
+		LayOut();
+	}
+}
+
+void SdfText::SetColor(const Color& c) {
+	color = c;
+	for (Vertex& v : quads) {
+		v.color = c;
+	}
+}
+
+void SdfText::SetPosition(const Vector2f& p) {
+	position = p;
+}
+
+const String& SdfText::GetString() const {
+	return string;
+}
+
+Color SdfText::GetColor() const {
+	return color;
+}
+
+Vector2f SdfText::GetPosition() const {
+	return position;
+}
+
+FloatRect SdfText::GetLocalBounds() const {
+	return bounds;
+}
+
+const std::vector<Vertex>& SdfText::GetQuads() const {
+	return quads;
+}
+
+void SdfText::Draw(RenderTarget& target, RenderStates states) const {
+	TextBatch batch;
+	batch.Add(*this);
+	batch.Draw(target, states);
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "SdfFont.h"
+
+using namespace sf;
+
+//One line of UI text drawn from UiFont() at any size. Stands in for sf::Text: the glyph
+//quads are laid out when the string, size or style change, and a TextBatch draws any
+//number of texts with one call.
+class SdfText {
+private:
+	String string;
+	unsigned int size = 30;
+	bool bold = false;
+	Color color = Color::White;
+	Vector2f position;
+	std::vector<Vertex> quads; //relative to the position
+	FloatRect bounds;
+
+	void LayOut();
+public:
+	SdfText() {}
+	SdfText(const String& string, const unsigned int& size, const bool& bold = false);
+
+	void SetString(const String& s);
+	void SetSize(const unsigned int& s);
+	void SetBold(const bool& b);
+	void SetColor(const Color& c);
+	void SetPosition(const Vector2f& p);
+
+	const String& GetString() const;
+	Color GetColor() const;
+	Vector2f GetPosition() const;
+	FloatRect GetLocalBounds() const; //as sf::Text::getLocalBounds
+	const std::vector<Vertex>& GetQuads() const;
+	void Draw(RenderTarget& target, RenderStates states = RenderStates::Default) const; //alone, one call
+};
@@ -1,11 +1,9 @@
 #include "Menu.h"
 
 void Settings(RenderWindow& window, Music& music) {
-    Texture bg_texture;
-    bg_texture.loadFromFile("images/background.png");
-    bg_texture.setRepeated(true);
+    std::shared_ptr<const Texture> bg_texture = LoadTexture("images/background.png", false, true);
     Sprite bg_sprite;
-    bg_sprite.setTexture(bg_texture);
+    bg_sprite.setTexture(*bg_texture);
     bg_sprite.setTextureRect({ 0, 0, int(window_x()), int(window_y()) });
 
     Object title("Settings.png", { 0, 0 }, 600, 100, 0);
@@ -30,6 +28,8 @@ void Settings(RenderWindow& window, Music& music) {
     int selected = 0; //selected item or button
 
     View view;
+    SpriteBatch sprites; //one draw call for the whole screen with the atlas
+    TextBatch labels; //and one for all the texts
     while (selecting && window.isOpen()) {
 
         view.setCenter(sf::Vector2f(window_x() / 2, window_y() / 2));
@@ -122,13 +122,23 @@ void Settings(RenderWindow& window, Music& music) {
 
         window.clear();
         window.draw(bg_sprite);
+        sprites.Clear();
+        labels.Clear();
         for (auto& item : items) {
-            item.Draw(window);
+            item.DrawSprites(sprites);
         }
         for (auto& button : buttons) {
-            button.Draw(window);
+            button.DrawSprites(sprites);
         }
-        title.Draw(window);
+        title.DrawSprites(sprites);
+        sprites.Draw(window);
+        for (auto& item : items) {
+            item.DrawLabels(labels);
+        }
+        for (auto& button : buttons) {
+            button.DrawLabels(labels);
+        }
+        labels.Draw(window);
 
         window.display();
     }
@@ -20,22 +20,33 @@ SettingsItem::SettingsItem(const Vector2f& pos, const String& s) :
 	right("ArrowRight.png", { pos.x + width - 15, pos.y }, 30, 60, 0),
 	value(0)
 {
-	font.loadFromFile("fonts/FRAHV.ttf");
-	item_text = Text(s, font, 50);
-	item_text.setPosition({ pos.x + 10, pos.y + 10 });
+	item_text = SdfText(s, 50);
+	item_text.SetPosition({ pos.x + 10, pos.y + 10 });
 
 	std::stringstream ss;
 	ss << std::setw(3) << std::setfill('0') << value;
-	val_text = Text(ss.str(), font, 50);
-	val_text.setPosition({ left.GetPosition().x + 35, pos.y });
+	val_text = SdfText(ss.str(), 50);
+	val_text.SetPosition({ left.GetPosition().x + 35, pos.y });
 }
 
 void SettingsItem::Draw(RenderWindow& window) const {
 	Object::Draw(window);
 	left.Draw(window);
 	right.Draw(window);
-	window.draw(item_text);
-	window.draw(val_text);
+	TextBatch labels;
+	DrawLabels(labels);
+	labels.Draw(window);
+}
+
+void SettingsItem::DrawSprites(SpriteBatch& batch) const {
+	Object::DrawSprites(batch);
+	left.DrawSprites(batch);
+	right.DrawSprites(batch);
+}
+
+void SettingsItem::DrawLabels(TextBatch& batch) const {
+	batch.Add(item_text);
+	batch.Add(val_text);
 }
 
 void SettingsItem::Inc(const int& n) {
@@ -68,7 +79,7 @@ int SettingsItem::GetValue() const {
 void SettingsItem::Update() {
 	std::stringstream ss;
 	ss << std::setw(3) << std::setfill('0') << value;
-	val_text.setString(ss.str());
+	val_text.SetString(ss.str());
 }
 
 void SettingsItem::SetSelected(bool selected) {
@@ -76,15 +87,15 @@ void SettingsItem::SetSelected(bool selected) {
 		SetColor(sel_color);
 		right.SetColor(sel_color);
 		left.SetColor(sel_color);
-		item_text.setFillColor(Color(0xffffffff));
-		val_text.setFillColor(Color(0xffffffff));
+		item_text.SetColor(Color(0xffffffff));
+		val_text.SetColor(Color(0xffffffff));
 	}
 	else {
 		SetColor(not_sel_color);
 		right.SetColor(not_sel_color);
 		left.SetColor(not_sel_color);
-		item_text.setFillColor(Color(0xffffffdf));
-		val_text.setFillColor(Color(0xffffffdf));
+		item_text.SetColor(Color(0xffffffdf));
+		val_text.SetColor(Color(0xffffffdf));
 	}
 }
 
@@ -9,9 +9,8 @@ private:
 	Object left;
 	Object right;
 	int value;
-	Font font;
-	Text item_text;
-	Text val_text;
+	SdfText item_text;
+	SdfText val_text;
 	Vector2f position;
 	String name;
 	Color sel_color = Color(0x0000f0ff);
@@ -22,6 +21,8 @@ public:
 	SettingsItem(const Vector2f& pos, const String& s);
 	SettingsItem(const Vector2f& pos, const String& s, const int& val);
 	void Draw(RenderWindow& window) const;
+	void DrawSprites(SpriteBatch& batch) const;
+	void DrawLabels(TextBatch& batch) const;
 	void Inc(const int& n);
 	void Dec(const int& n);
 	void SetValue(const int& n);
@@ -77,9 +77,15 @@ void Ship::UpdateEnginesPosition(const std::string& name, const Vector2f& new_po
 }
 
 void Ship::DrawShip(RenderWindow& window) const {
-	Draw(window);
+	SpriteBatch batch;
+	DrawShip(batch);
+	batch.Draw(window);
+}
+
+void Ship::DrawShip(SpriteBatch& batch) const {
+	DrawSprites(batch);
 	for (const auto& e : engines) {
-		e.second.Draw(window);
+		e.second.DrawSprites(batch);
 	}
 }
 
@@ -26,7 +26,8 @@ public:
 	void UpdateShipPosition(const float& dt);
 	void UpdateEnginesPosition(const std::string& name, const sf::Vector2f& new_position);
 
-	virtual void DrawShip(RenderWindow& window) const;
+	void DrawShip(RenderWindow& window) const;
+	virtual void DrawShip(SpriteBatch& batch) const; //hull, then the engines
 	void Destroy();
 	void draw_all(RenderWindow& window, bool position, bool speed, bool way, bool forces, bool collision);
 
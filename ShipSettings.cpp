@@ -1,12 +1,24 @@
 #include "Menu.h"
+#include "LoadingScreen.h"
+
+//the stands, then what the ship constructors load
+static const char* const SHIP_IMAGES[] = { "Lunar_Lander_Mark1.png", "Dron.png", "Rick&Morty.png", "SuperPuperShipMini.png",
+                                           "SuperPuperShip.png", "fire.png", "bluefire.png", "fireleft.png", "fireright.png", "Plumbus.png" };
 
 Ship* ShipSettings(RenderWindow& window, const Vector2f& position, bool& if_Menu) {
 
-    Texture bg_texture;
-    bg_texture.loadFromFile("images/background.png");
-    bg_texture.setRepeated(true);
+    std::shared_ptr<const SoundBuffer> engine_sound; //held until the ship's engines have their own handles
+    LoadingScreen loading("Preparing the ship");
+    loading.Start("Ships", [&engine_sound] { //decoded while the player chooses, the constructors only upload
+        for (const char* image : SHIP_IMAGES) {
+            PrefetchImage(std::string("images/") + image);
+        }
+        engine_sound = LoadSound("sounds/engine.wav");
+    });
+
+    std::shared_ptr<const Texture> bg_texture = LoadTexture("images/background.png", false, true);
     Sprite bg_sprite;
-    bg_sprite.setTexture(bg_texture);
+    bg_sprite.setTexture(*bg_texture);
     bg_sprite.setTextureRect({ 0, 0, int(window_x()), int(window_y()) });
 
     Object title("ShipSettings.png", { 0, 0 }, 600, 100, 0);
@@ -37,6 +49,8 @@ Ship* ShipSettings(RenderWindow& window, const Vector2f& position, bool& if_Menu
     int chosen = 0;
 
     View view;
+    SpriteBatch sprites; //one draw call for the whole screen with the atlas
+    TextBatch labels; //and one for all the texts
     while (selecting && window.isOpen()) {
 
         view.setCenter(sf::Vector2f(window_x() / 2, window_y() / 2));
@@ -124,25 +138,45 @@ Ship* ShipSettings(RenderWindow& window, const Vector2f& position, bool& if_Menu
         window.clear();
         window.draw(bg_sprite);
         
+        sprites.Clear();
+        labels.Clear();
+        for (const auto& button : buttons) {
+            button.DrawSprites(sprites);
+        }
+        title.DrawSprites(sprites);
+        for (const auto& stand : stands) {
+            stand.DrawSprites(sprites);
+        }
+        sprites.Draw(window);
         for (const auto& button : buttons) {
-            button.Draw(window);
+            button.DrawLabels(labels);
         }
-        title.Draw(window);
         for (const auto& stand : stands) {
-            stand.Draw(window);
+            stand.DrawLabels(labels);
         }
+        labels.Draw(window);
         window.display();
     }
 
-    //Ship* ship;
+    loading.Run(window);
+    loading.Join(); //the window may have been closed before the prefetch ended
+    Ship* ship = nullptr;
     switch (chosen) {
     case 0:
-        return new Lunar_Lander_Mark1(position);
+        ship = new Lunar_Lander_Mark1(position);
+        break;
     case 1:
-        return new Dron(position);
+        ship = new Dron(position);
+        break;
     case 2:
-        return new RickAndMorty(position);
+        ship = new RickAndMorty(position);
+        break;
     case 3:
-        return new SuperPuperShip(position);
+        ship = new SuperPuperShip(position);
+        break;
+    }
+    for (const char* image : SHIP_IMAGES) { //what the other ships would have used
+        ForgetImage(std::string("images/") + image);
     }
+    return ship;
 }
\ No newline at end of file
@@ -10,34 +10,42 @@ ShipStand::ShipStand(const String& f, const String& _name, const Vector2f& pos)\
 	float ship_x = position.x + (width - ship.GetWidth()) / 2;
 	float ship_y = position.y + (height - ship.GetHeight()) / 2 - 30;
 	ship.SetPosition({ ship_x, ship_y }, 0);
-	font.loadFromFile("fonts/FRAHV.ttf");
-	name_text = Text(name, font, 35);
-	name_text.setPosition({ position.x + width / 2 - name_text.getLocalBounds().width / 2,
+	name_text = SdfText(name, 35);
+	name_text.SetPosition({ position.x + width / 2 - name_text.GetLocalBounds().width / 2,
 					position.y + height - 50 });
 }
 
 void ShipStand::SetSelected(bool selected) {
 	if (selected) {
 		SetColor(sel_color);
-		name_text.setFillColor(Color(0xffffffff));
+		name_text.SetColor(Color(0xffffffff));
 	}
 	else {
 		SetColor(not_sel_color);
-		name_text.setFillColor(Color(0xffffffdf));
+		name_text.SetColor(Color(0xffffffdf));
 	}
 }
 
 void ShipStand::SetChosen(bool chosen) {
 	if (chosen) {
-		name_text.setFillColor(sel_color);
+		name_text.SetColor(sel_color);
 	}
 	else {
-		name_text.setFillColor(Color(0xffffffff));
+		name_text.SetColor(Color(0xffffffff));
 	}
 }
 
 void ShipStand::Draw(RenderWindow& window) const {
 	ship.Draw(window);
 	Object::Draw(window);
-	window.draw(name_text);
+	name_text.Draw(window);
 }
+
+void ShipStand::DrawSprites(SpriteBatch& batch) const {
+	ship.DrawSprites(batch);
+	Object::DrawSprites(batch);
+}
+
+void ShipStand::DrawLabels(TextBatch& batch) const {
+	batch.Add(name_text);
+}
\ No newline at end of file
@@ -4,8 +4,7 @@
 class ShipStand : public Object {
 private:
 	Object ship;
-	Font font;
-	Text name_text;
+	SdfText name_text;
 	String name;
 	Color sel_color = Color(0x0000f0ff);
 	Color not_sel_color = Color(0x0000f080);
@@ -17,4 +16,6 @@ public:
 	void SetSelected(bool selected);
 	void SetChosen(bool chosen);
 	void Draw(RenderWindow& window) const;
+	void DrawSprites(SpriteBatch& batch) const;
+	void DrawLabels(TextBatch& batch) const;
 };
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include "Simulation.h"
+#include <algorithm>
+
+Simulation::Simulation(Ship* s, Surface& planet, const float& rate, std::function<void(Ship*)> f)
+	: ship(s), surface(planet), step(1 / rate), io(f) {
+	Publish(); //the first frame has something to draw
+	thread = std::thread(&Simulation::Run, this);
+}
+
+Simulation::~Simulation() {
+	stop = true;
+	thread.join();
+}
+
+void Simulation::Run() {
+	Clock clock;
+	float lag = 0;
+	while (!stop) {
+		lag = std::min(lag + clock.restart().asSeconds(), 0.25f); //after a stall, no catching up
+		bool stepped = false;
+		while (lag >= step) {
+			lag -= step;
+			if (!paused) {
+				Step();
+				stepped = true;
+			}
+		}
+		if (stepped) {
+			Publish();
+		}
+		sleep(seconds(step - lag));
+	}
+}
+
+void Simulation::Step() {
+	std::lock_guard<std::mutex> lock(world);
+	ship->control();
+	//ship->updateAirForce(surface.GetAirDensity());
+	ship->UpdateShipPosition(step);
+	ship->CollisionDetection(surface);
+	ship->DrawFlyStatus(step);
+	int status = ship->GetFlyStatus();
+	if (!crashed && status >= 2 && status <= 5) { //bad landing
+		crashed = true;
+		crater_x = ship->GetCenterPosition().x;
+		crater_radius = ship->GetWidth();
+		crater_depth = ship->GetHeight() / 2;
+	}
+	if (io) {
+		io(ship);
+	}
+	time += step;
+}
+
+void Simulation::Publish() {
+	std::lock_guard<std::mutex> lock(world);
+	FlightSnapshot& s = snapshots.Back();
+	s.ship.Clear();
+	ship->DrawShip(s.ship);
+	s.flight = ReadFlight(*ship, surface);
+	s.crashed = crashed;
+	s.crater_x = crater_x;
+	s.crater_radius = crater_radius;
+	s.crater_depth = crater_depth;
+	s.time = time;
+	snapshots.Publish();
+}
+
+const FlightSnapshot& Simulation::Latest() {
+	snapshots.Update();
+	return snapshots.Front();
+}
+
+void Simulation::SetPaused(const bool& p) {
+	paused = p;
+}
+
+void Simulation::Apply(const std::function<void()>& change) {
+	std::lock_guard<std::mutex> lock(world);
+	change();
+}
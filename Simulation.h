@@ -0,0 +1,57 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include "Ship.h"
+#include "Surface.h"
+#include "TripleBuffer.h"
+#include "Interface.h"
+
+using namespace sf;
+
+#define SIMULATION_RATE 120 //steps per second on the simulation thread
+
+//Everything the render thread needs of one simulation step.
+struct FlightSnapshot {
+	SpriteBatch ship; //ship and engines
+	FlightReadout flight; //HUD values, center for the camera
+	bool crashed = false; //the crater below is to be dug, once
+	float crater_x = 0, crater_radius = 0, crater_depth = 0;
+	double time = 0; //simulated seconds
+};
+
+//Runs the flight on its own thread at a fixed rate: input, physics, collisions and the
+//serial port. Each step is published as a FlightSnapshot through a triple buffer, so
+//neither a slow display nor a slow step holds the other up. The ship belongs to the
+//thread until the Simulation is destroyed; the surface is only read by it, and changed
+//by the render thread through Apply.
+class Simulation {
+private:
+	Ship* ship;
+	Surface& surface;
+	float step; //s
+	std::function<void(Ship*)> io; //after each step, on the simulation thread
+	TripleBuffer<FlightSnapshot> snapshots;
+	std::mutex world; //held by a step, and by Apply
+	std::atomic<bool> paused{ false };
+	std::atomic<bool> stop{ false };
+	bool crashed = false;
+	float crater_x = 0, crater_radius = 0, crater_depth = 0;
+	double time = 0;
+	std::thread thread;
+
+	void Run();
+	void Step();
+	void Publish();
+public:
+	Simulation(Ship* ship, Surface& surface, const float& rate, std::function<void(Ship*)> io);
+	Simulation(const Simulation&) = delete;
+	Simulation& operator = (const Simulation&) = delete;
+	~Simulation(); //stops and joins the thread
+
+	const FlightSnapshot& Latest(); //render thread: the newest published step
+	void SetPaused(const bool& p);
+	void Apply(const std::function<void()>& change); //render thread: changes the world between steps
+};
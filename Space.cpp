@@ -1,14 +1,13 @@
 #include "Space.h"
 
-Space::Space(const String& f, const Vector2f& pos) : file(f), start_pos(pos) {
-	image.loadFromFile("images/" + f);
-	texture.loadFromImage(image);
-	texture.setRepeated(true);
-	sprite.setTexture(texture);
-	sprite.setTextureRect(IntRect(rand() % 1000, rand() % 1000, 3 * window_x(), 3 * window_y()));
+Space::Space(const String& f, const Vector2f& pos, unsigned int seed) : file(f), start_pos(pos) {
+	Random rnd(seed, 0, Stream::SPACE);
+	texture = LoadTexture("images/" + f, false, true);
+	sprite.setTexture(*texture);
+	sprite.setTextureRect(IntRect(rnd(1000), rnd(1000), 3 * WORLD_VIEW_WIDTH, 3 * WORLD_VIEW_HEIGHT));
 
 	bodies.push_back(Object{ "Venera.png", {0,0}, 152, 152, 0 });
-	switch (rand() % 5) {
+	switch (rnd(5)) {
 	case 0:
 		bodies[0].SetColor(Color::Cyan);
 		break;
@@ -26,23 +25,33 @@ Space::Space(const String& f, const Vector2f& pos) : file(f), start_pos(pos) {
 		break;
 	}
 
-	float x = (rand() % 10 / 10.0 - 0.5) * window_x();
-	float y = -(rand() % 10 / 20.0) * window_y();
+	float x = (rnd(10) / 10.0 - 0.5) * WORLD_VIEW_WIDTH;
+	float y = -(rnd(10) / 20.0) * WORLD_VIEW_HEIGHT;
 	positions.push_back({ x,y });
 }
+void Space::Prefetch(const String& file) {
+	PrefetchImage("images/" + file);
+	PrefetchImage("images/Venera.png");
+}
 void Space::Update(const View& view) {
-	float x = view.getCenter().x - 1.5*window_x() - view.getCenter().x / 100;
-	float y = view.getCenter().y - 1.5*window_y() - view.getCenter().y / 100;
+	IntRect rect = sprite.getTextureRect(); //the background covers 3x3 views of any aspect ratio
+	rect.width = 3 * view.getSize().x;
+	rect.height = 3 * view.getSize().y;
+	sprite.setTextureRect(rect);
+	float x = view.getCenter().x - 1.5*view.getSize().x - view.getCenter().x / 100;
+	float y = view.getCenter().y - 1.5*view.getSize().y - view.getCenter().y / 100;
 	sprite.setPosition(x, y);
 
 	x = positions[0].x + view.getCenter().x + (start_pos.x - view.getCenter().x) / 100;
 	y = positions[0].y + view.getCenter().y + (start_pos.y - view.getCenter().y) / 100;
 	bodies[0].SetPosition({x,y}, 0);
 }
-void Space::Draw(RenderWindow& window) const {
+void Space::Draw(RenderTarget& window) const {
 	window.draw(sprite);
 
+	SpriteBatch batch;
 	for (const auto& b : bodies) {
-		b.Draw(window);
+		b.DrawSprites(batch);
 	}
+	batch.Draw(window);
 }
@@ -7,14 +7,14 @@ using namespace sf;
 class Space {
 private:
 	String file;
-	Image image;
-	Texture texture;
+	std::shared_ptr<const Texture> texture;
 	Sprite sprite;
 	std::vector<Object> bodies;
 	std::vector<Vector2f> positions;
 	Vector2f start_pos;
 public:
-	Space(const String& f, const Vector2f&);
+	Space(const String& f, const Vector2f&, unsigned int seed);
+	static void Prefetch(const String& file); //decodes the images, any thread; the constructor only uploads them
 	void Update(const View& view);
-	void Draw(RenderWindow& window) const;
+	void Draw(RenderTarget& window) const;
 };
\ No newline at end of file
@@ -0,0 +1,45 @@
+#include "SpriteBatch.h"
+
+void SpriteBatch::Add(const Sprite& sprite) {
+	const Texture* texture = sprite.getTexture();
+	if (!texture) {
+		return;
+	}
+	const Transform& transform = sprite.getTransform();
+	IntRect rect = sprite.getTextureRect();
+	FloatRect bounds = sprite.getLocalBounds();
+	Color color = sprite.getColor();
+
+	float left = rect.left, right = float(rect.left + rect.width); //negative width flips
+	float top = rect.top, bottom = float(rect.top + rect.height);
+	Vertex quad[4] = {
+		Vertex(transform.transformPoint(0, 0), color, { left, top }),
+		Vertex(transform.transformPoint(bounds.width, 0), color, { right, top }),
+		Vertex(transform.transformPoint(bounds.width, bounds.height), color, { right, bottom }),
+		Vertex(transform.transformPoint(0, bounds.height), color, { left, bottom })
+	};
+	if (runs.empty() || runs.back().texture != texture) {
+		runs.push_back(Run{ texture, vertices.size(), 0 });
+	}
+	static const int order[6] = { 0, 1, 2, 0, 2, 3 };
+	for (int i : order) {
+		vertices.push_back(quad[i]);
+	}
+	runs.back().count += 6;
+}
+
+void SpriteBatch::Clear() {
+	vertices.clear();
+	runs.clear();
+}
+
+void SpriteBatch::Draw(RenderTarget& target, RenderStates states) const {
+	for (const auto& run : runs) {
+		states.texture = run.texture;
+		target.draw(&vertices[run.first], run.count, Triangles, states);
+	}
+}
+
+size_t SpriteBatch::DrawCalls() const {
+	return runs.size();
+}
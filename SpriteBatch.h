@@ -0,0 +1,23 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+using namespace sf;
+
+//Collects sprites into one triangle list and draws each run of sprites sharing a texture
+//with one call. Sprites are drawn in the order they were added, so the order within a
+//layer is kept; with the atlas the whole layer is usually a single run.
+class SpriteBatch {
+private:
+	struct Run {
+		const Texture* texture;
+		size_t first, count; //vertices
+	};
+	std::vector<Vertex> vertices;
+	std::vector<Run> runs;
+public:
+	void Add(const Sprite& sprite);
+	void Clear();
+	void Draw(RenderTarget& target, RenderStates states = RenderStates::Default) const;
+	size_t DrawCalls() const;
+};
@@ -88,11 +88,11 @@ void SuperPuperShip::control() {
 	}
 }
 
-void SuperPuperShip::DrawShip(RenderWindow & window) const {
-	Draw(window);
+void SuperPuperShip::DrawShip(SpriteBatch& batch) const {
+	DrawSprites(batch);
 	for (const auto& e : engines) {
 		if (e.second.If_on()) {
-			e.second.Draw(window);
+			e.second.DrawSprites(batch);
 		}
 	}
 }
@@ -12,6 +12,7 @@ public:
 	RigidBodyParameters download(sf::Vector2f position);
 	void assembly();
 	void control();
-	virtual void DrawShip(RenderWindow& window) const;
+	using Ship::DrawShip;
+	virtual void DrawShip(SpriteBatch& batch) const;
 };
 
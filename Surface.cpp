@@ -1,4 +1,5 @@
 #include "Surface.h"
+#include <algorithm>
 
 size_t screen_x() {
     return VideoMode::getDesktopMode().width;
@@ -13,45 +14,282 @@ size_t window_y() {
     return screen_y() - 300;
 }
 
-void mix(std::vector<int>& v) {
+View GameView(const RenderTarget& window, const Vector2f& center) {
+    float aspect = float(window.getSize().x) / std::max(window.getSize().y, 1u);
+    return View(center, Vector2f(WORLD_VIEW_HEIGHT * aspect, WORLD_VIEW_HEIGHT));
+}
+
+void mix(std::vector<int>& v, Random& rnd) {
     for (int i = 0; i < v.size(); ++i) {
-        int j = rand() % v.size();
+        int j = rnd(v.size());
         int temp = v[i];
         v[i] = v[j];
         v[j] = temp;
     }
 }
 
+Feature::Feature(const VertexArray& v) : vertices(v) {
+    FloatRect bounds = v.getBounds();
+    left = bounds.left;
+    right = bounds.left + bounds.width;
+}
+
+bool Feature::Overlaps(const float& x_left, const float& x_right) const {
+    return right >= x_left && left <= x_right;
+}
+
+void Feature::Upload() {
+    buffer.reset();
+    if (vertices.getVertexCount() == 0) {
+        return;
+    }
+    std::unique_ptr<VertexBuffer> b(new VertexBuffer(vertices.getPrimitiveType(), VertexBuffer::Static));
+    if (b->create(vertices.getVertexCount()) && b->update(&vertices[0])) {
+        buffer = std::move(b);
+    }
+}
+
+void Feature::Draw(RenderTarget& window, const RenderStates& states) const {
+    if (buffer) {
+        window.draw(*buffer, states);
+    }
+    else {
+        window.draw(vertices, states);
+    }
+}
+
+Shader* LakeShader() {
+    static Shader shader;
+    static bool loaded = Shader::isAvailable() &&
+        shader.loadFromFile("shaders/lake.vert", "shaders/lake.frag");
+    return loaded ? &shader : nullptr;
+}
+
+const Texture& IceTexture() {
+    static std::shared_ptr<const Texture> t = LoadTexture("images/ice.png", false, true);
+    return *t;
+}
+
+const Texture& MeteoriteTexture() {
+    static std::shared_ptr<const Texture> t = LoadTexture("images/meteorite.png", false, true);
+    return *t;
+}
+
 Surface::Surface(const String& f, const int& _rough, const int& snow_cov, std::map<Hole, int> prob, 
-            int m_angle, int _gravity, int air_d)
+            int m_angle, int _gravity, int air_d, unsigned int _seed, Generator _generator,
+            const std::atomic<bool>* _cancel)
 : rough(_rough), file(f), snow_coverage(snow_cov), probability(prob), 
-        max_angle(m_angle), gravity(_gravity), air_density(air_d) {
-    pixel_size = 20 * window_x();
-    left_position = Vector2f(-pixel_size/2, window_y() - 100);
+        max_angle(m_angle), gravity(_gravity), air_density(air_d), seed(_seed), generator(_generator), cancel(_cancel) {
+    pixel_size = WORLD_WIDTH;
+    left_position = Vector2f(-pixel_size/2, WORLD_START_Y);
     vertex_count = size_t(pixel_size / x_spacing);
-    surface.setPrimitiveType(TriangleStrip);
-    Generate();
+    from_cache = LoadCache();
+    if (!from_cache) {
+        Generate();
+    }
+    if (!cancel) {
+        Finish();
+    }
+}
+
+bool Surface::Cancelled() const {
+    return cancel && cancel->load();
+}
+
+void Surface::Finish() {
+    cancel = nullptr;
+    if (!from_cache) { //only planets that are played are saved, not every preview
+        SaveCache();
+        from_cache = true;
+    }
+    SetTexture();
+}
+
+void Surface::Prefetch(const String& file) {
+    PrefetchImage("images/" + file);
+    PrefetchImage("images/ice.png");
+    PrefetchImage("images/meteorite.png");
 }
 
 int Surface::Get_iter_0() const { return iter_0; }
 
 float Surface::YtoX(const float& x) {
-    int iter = iter_0 + 1 + 2*int(x)/ x_spacing;
-    if (x < left_position.x || x > left_position.x + vertex_count*x_spacing) {
-        throw std::out_of_range("Surface::YtoX()");
-    }
-    return surface[iter].position.y;
+    return Sampler().Height(x);
+}
+
+TerrainSampler Surface::Sampler() const {
+    return TerrainSampler(heights.data(), heights.size(), left_position.x, x_spacing);
+}
+
+const LandingSites& Surface::GetLandingSites() const {
+    return sites;
+}
+
+void Surface::BuildLandingSites() {
+    sites.Build(heights, materials, left_position.x, x_spacing, 3 * x_spacing);
 }
 
 float Surface::Get_spacing() const { return x_spacing; }
 
 size_t Surface::Get_VertexCount() const {
-    return surface.getVertexCount();
+    return 2 * heights.size();
 }
 Vertex Surface::GetVertex(const int& i) const {
-    if (i >= 0 && i < surface.getVertexCount()) { return surface[i]; }
-    else if (i < 0) { return surface[0]; }
-    else { return surface[surface.getVertexCount() - 1]; }
+    int count = Get_VertexCount();
+    int iter = i < 0 ? 0 : (i < count ? i : count - 1);
+    Vector2f position(GetSampleX(iter / 2), iter % 2 == 0 ? heights[iter / 2] : down_border);
+    return Vertex(position, surface_color, position);
+}
+
+size_t Surface::GetSampleCount() const {
+    return heights.size();
+}
+float Surface::GetSampleX(const int& i) const {
+    return left_position.x + i * x_spacing;
+}
+float Surface::GetSampleHeight(const int& i) const {
+    return heights[i];
+}
+Material Surface::GetMaterial(const int& i) const {
+    return materials[i];
+}
+
+void Surface::VisibleSamples(const float& x_left, const float& x_right, int& first, int& last) const {
+    //O(1): samples are evenly spaced from left_position.x
+    first = std::max(int(floor((x_left - left_position.x) / x_spacing)), 0);
+    last = std::min(int(ceil((x_right - left_position.x) / x_spacing)) + 1, int(heights.size()));
+}
+
+void Surface::BuildStrip(VertexArray& out, int first, int last, int stride) const {
+    first = std::max(first, 0);
+    last = std::min(last, int(heights.size()));
+    out.setPrimitiveType(TriangleStrip);
+    out.clear();
+    for (int i = first; i < last; i += stride) {
+        if (i + stride >= last) {
+            i = last - 1; //the last sample is always kept so decimated strips still join
+        }
+        Vector2f top(GetSampleX(i), heights[i]);
+        Vector2f bottom(top.x, down_border);
+        out.append(Vertex(top, surface_color, top));
+        out.append(Vertex(bottom, surface_color, bottom));
+    }
+}
+
+int Surface::LodLevel(const RenderTarget& window) const {
+    float pixels = x_spacing * window.getSize().x / window.getView().getSize().x; //between two samples
+    int level = 0;
+    while (level + 1 < lod_levels && LodStride(level) * pixels < lod_pixels) {
+        ++level;
+    }
+    return level;
+}
+
+int Surface::LodStride(const int& level) const {
+    return 1 << (2 * level);
+}
+
+int Surface::ChunkCount() const {
+    return (heights.size() + chunk_size - 1) / chunk_size;
+}
+
+void Surface::ChunkFeatures(const std::vector<Feature>& features, const int& c, int& first, int& last) const {
+    //features are generated left to right, so they are sorted by x
+    auto by_left = [](const Feature& f, const float& x) { return f.left < x; };
+    first = std::lower_bound(features.begin(), features.end(), GetSampleX(c * chunk_size), by_left) - features.begin();
+    last = std::lower_bound(features.begin() + first, features.end(), GetSampleX((c + 1) * chunk_size), by_left) - features.begin();
+    if (c == 0) {
+        first = 0;
+    }
+    if (c + 1 == ChunkCount()) {
+        last = features.size();
+    }
+}
+
+Feature Surface::BuildBatch(const std::vector<Feature>& features, const int& c) const {
+    int first, last;
+    ChunkFeatures(features, c, first, last);
+    VertexArray batch(Triangles);
+    for (int f = first; f < last; ++f) { //strip -> triangle list, so features join without degenerate triangles
+        const VertexArray& v = features[f].vertices;
+        for (int i = 0; i + 2 < v.getVertexCount(); ++i) {
+            batch.append(v[i]);
+            batch.append(v[i + 1]);
+            batch.append(v[i + 2]);
+        }
+    }
+    return Feature(batch);
+}
+
+void Surface::BuildBatches() {
+    int chunk_count = ChunkCount();
+    std::vector<Feature>* features[4] = { &lakes, &snow, &glaciers, &meteorites };
+    std::vector<Feature>* batches[4] = { &lake_batches, &snow_batches, &glacier_batches, &meteorite_batches };
+    for (int g = 0; g < 4; ++g) {
+        batches[g]->clear();
+        for (int c = 0; c < chunk_count; ++c) {
+            batches[g]->emplace_back(VertexArray(Triangles));
+        }
+    }
+    Workers().ParallelFor(0, 4 * chunk_count, 16, [&](int first, int last) {
+        for (int k = first; k < last; ++k) {
+            (*batches[k / chunk_count])[k % chunk_count] = BuildBatch(*features[k / chunk_count], k % chunk_count);
+        }
+    });
+}
+
+void Surface::UploadBuffers() {
+    chunk_buffers.clear();
+    for (auto& lake : lake_batches) { lake.buffer.reset(); }
+    for (auto& glacier : glacier_batches) { glacier.buffer.reset(); }
+    for (auto& meteorite : meteorite_batches) { meteorite.buffer.reset(); }
+    for (auto& snow_piece : snow_batches) { snow_piece.buffer.reset(); }
+    if (!VertexBuffer::isAvailable() || heights.empty()) {
+        return; //Draw falls back to vertices derived every frame
+    }
+
+    int chunk_count = ChunkCount();
+    //strips are built on the pool, only the GL uploads stay on this thread
+    std::vector<VertexArray> chunks(lod_levels * chunk_count);
+    Workers().ParallelFor(0, chunks.size(), 8, [&](int first, int last) {
+        for (int k = first; k < last; ++k) {
+            int level = k / chunk_count, c = k % chunk_count;
+            //+1 - joins with the next chunk
+            BuildStrip(chunks[k], c * chunk_size, (c + 1) * chunk_size + 1, LodStride(level));
+        }
+    });
+    chunk_buffers.resize(lod_levels);
+    for (auto& level : chunk_buffers) {
+        level.reserve(chunk_count);
+    }
+    for (int k = 0; k < chunks.size(); ++k) {
+        const VertexArray& chunk = chunks[k];
+        std::unique_ptr<VertexBuffer> buffer(new VertexBuffer(TriangleStrip, VertexBuffer::Static));
+        if (!buffer->create(chunk.getVertexCount()) || !buffer->update(&chunk[0])) {
+            chunk_buffers.clear();
+            return;
+        }
+        chunk_buffers[k / chunk_count].push_back(std::move(buffer));
+    }
+    if (LakeShader()) { //otherwise lakes are animated on the CPU and stay there
+        for (auto& lake : lake_batches) { lake.Upload(); }
+    }
+    for (auto& glacier : glacier_batches) { glacier.Upload(); }
+    for (auto& meteorite : meteorite_batches) { meteorite.Upload(); }
+    for (auto& snow_piece : snow_batches) { snow_piece.Upload(); }
+}
+
+Color Surface::MaterialColor(const Material& m) const {
+    switch (m) {
+    case Material::LAKE:
+        return lakes_color;
+    case Material::ICE:
+        return Color::White;
+    case Material::METEORITE:
+        return meteorites_color;
+    default:
+        return surface_color;
+    }
 }
 
 int Surface::GetGravity() const {
@@ -60,86 +298,126 @@ int Surface::GetGravity() const {
 int Surface::GetAirDensity() const {
     return air_density;
 }
+unsigned int Surface::GetSeed() const {
+    return seed;
+}
+Generator Surface::GetGenerator() const {
+    return generator;
+}
 
 void Surface::SetTexture() {
-    texture.loadFromFile("images/" + file);
-    texture.setRepeated(true);
-    int count = surface.getVertexCount();
-    for (int i = 0; i < count; ++i) {
-        surface[i].texCoords = surface[i].position;
-        surface[i].color = surface_color;
-        if (surface[i].position.x == 0) {
-            iter_0 = i;
-        }
-    }
-    ice_texture.loadFromFile("images/ice.png");
-    ice_texture.setRepeated(true);
-    for (auto& glacier : glaciers) {
-        count = glacier.getVertexCount();
-        for (int i = 0; i < count; ++i) {
-            glacier[i].texCoords = glacier[i].position;
-            glacier[i].color = Color::White;
-        }
-    }
-    meteorite_texture.loadFromFile("images/meteorite.png");
-    meteorite_texture.setRepeated(true);
-    for (auto& meteorite : meteorites) {
-        count = meteorite.getVertexCount();
-        for (int i = 0; i < count; ++i) {
-            meteorite[i].texCoords = meteorite[i].position;
-            meteorite[i].color = meteorites_color;
-        }
-    }
-    for (auto& lake : lakes) {
-        count = lake.getVertexCount();
-        for (int i = 0; i < count; ++i) {
-            lake[i].color = lakes_color;
-        }
-    }
-    /*int start = rand() % count;
-    int end = start + rand() % (count / 10);
-    for (int i = start; i < end && i < count; ++i) {
-        surface[i].color = Color::Magenta;
-    }*/
-}
-
-void Surface::Update(const float& dt) { //water animation
-    static float timer = 0.5;
-    timer += dt;
-    if (timer > 1) {
-        timer = -1;
-    }
-    float shift;
-    for (auto& lake : lakes) {
-        for (int i = 0; i < lake.getVertexCount(); i += 2) {
-            if((i/2)%3 == 0) {
-                shift = timer / abs(timer) * 3 * dt;
+    texture = LoadTexture("images/" + file, false, true); //shared with the other planets of this image
+    UploadBuffers();
+}
+
+void Surface::PrepareRender() {
+    iter_0 = 2 * int(round(-left_position.x / x_spacing)) + 1; //bottom vertex of the sample at x = 0
+    //features are independent, the loops only touch their own arrays
+    Workers().ParallelFor(0, glaciers.size(), 4, [this](int first, int last) {
+        for (int f = first; f < last; ++f) {
+            VertexArray& glacier = glaciers[f].vertices;
+            int count = glacier.getVertexCount();
+            for (int i = 0; i < count; ++i) {
+                glacier[i].texCoords = glacier[i].position;
+                glacier[i].color = Color::White;
             }
-            else if((i / 2) % 3 == 2) {
-                shift = -timer / abs(timer) * 3 * dt;
+        }
+    });
+    Workers().ParallelFor(0, meteorites.size(), 4, [this](int first, int last) {
+        for (int f = first; f < last; ++f) {
+            VertexArray& meteorite = meteorites[f].vertices;
+            int count = meteorite.getVertexCount();
+            for (int i = 0; i < count; ++i) {
+                meteorite[i].texCoords = meteorite[i].position;
+                meteorite[i].color = meteorites_color;
             }
-            lake[i].position.y += shift;
-
         }
-    }
+    });
+    Workers().ParallelFor(0, lakes.size(), 4, [this](int first, int last) {
+        for (int f = first; f < last; ++f) {
+            VertexArray& lake = lakes[f].vertices;
+            int count = lake.getVertexCount();
+            for (int i = 0; i < count; ++i) {
+                lake[i].color = lakes_color;
+                //wave direction of the top vertices, read by Draw and lake.vert
+                float direction = (i / 2) % 3 == 2 ? -1 : 1;
+                lake[i].texCoords = Vector2f(i % 2 == 0 ? direction : 0, 0);
+            }
+        }
+    });
+    BuildBatches();
+}
+
+float Surface::WaveOffset(const float& t) {
+    //triangle wave: 2 s period, 3 px swing
+    float phase = t / 2 - floor(t / 2);
+    return 3 * (1 - abs(2 * phase - 1)) - 1.5f;
+}
+
+void Surface::Update(const float& dt) { //water animation, evaluated in Draw
+    time += dt;
 }
 
-void Surface::Draw(RenderWindow& window) const {
-    for (const auto& lake : lakes) {
-        window.draw(lake);
+void Surface::Draw(RenderTarget& window) const {
+    const View& view = window.getView();
+    float left = view.getCenter().x - view.getSize().x / 2;
+    float right = left + view.getSize().x;
+    int first, last;
+    VisibleSamples(left, right, first, last);
+    //a batch can reach into the next chunk, so one chunk to the left is checked too
+    int c_first = std::max(first / chunk_size - 1, 0);
+    int c_last = std::min(last / chunk_size, ChunkCount() - 1);
+
+    Shader* shader = LakeShader();
+    if (shader) {
+        shader->setUniform("time", time);
+    }
+    float wave = WaveOffset(time);
+    for (int c = c_first; c <= c_last && c < lake_batches.size(); ++c) {
+        const Feature& lake = lake_batches[c];
+        if (lake.vertices.getVertexCount() == 0 || !lake.Overlaps(left, right)) {
+            continue;
+        }
+        if (shader) {
+            lake.Draw(window, shader);
+        }
+        else {
+            lake_frame = lake.vertices;
+            for (int i = 0; i < lake_frame.getVertexCount(); ++i) { //texCoords.x is 0 at the bottom
+                lake_frame[i].position.y += lake_frame[i].texCoords.x * wave;
+            }
+            window.draw(lake_frame);
+        }
     }
 
-    for (const auto& glacier : glaciers) {
-        window.draw(glacier, &ice_texture);
+    for (int c = c_first; c <= c_last && c < glacier_batches.size(); ++c) {
+        if (glacier_batches[c].Overlaps(left, right)) {
+            glacier_batches[c].Draw(window, &IceTexture());
+        }
     }
 
-    for (const auto& meteorite : meteorites) {
-        window.draw(meteorite, &meteorite_texture);
+    for (int c = c_first; c <= c_last && c < meteorite_batches.size(); ++c) {
+        if (meteorite_batches[c].Overlaps(left, right)) {
+            meteorite_batches[c].Draw(window, &MeteoriteTexture());
+        }
     }
 
-    window.draw(surface, &texture);
+    int level = LodLevel(window);
+    if (!chunk_buffers.empty()) {
+        const auto& chunks = chunk_buffers[level];
+        for (int c = first / chunk_size; c < chunks.size() && c * chunk_size < last; ++c) {
+            window.draw(*chunks[c], texture.get());
+        }
+    }
+    else {
+        int stride = LodStride(level);
+        BuildStrip(strip, first / stride * stride, last, stride); //aligned, so samples don't jump while scrolling
+        window.draw(strip, texture.get());
+    }
 
-    for (const auto& snow_piece : snow) {
-        window.draw(snow_piece);
+    for (int c = c_first; c <= c_last && c < snow_batches.size(); ++c) {
+        if (snow_batches[c].Overlaps(left, right)) {
+            snow_batches[c].Draw(window, RenderStates::Default);
+        }
     }
-}
+}
\ No newline at end of file
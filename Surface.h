@@ -3,7 +3,15 @@
 #include <time.h>
 #include <iostream>
 #include <cmath>
+#include <functional>
+#include <atomic>
+#include <memory>
 #include "Object.h"
+#include "Random.h"
+#include "TerrainSampler.h"
+#include "LandingSites.h"
+#include "ThreadPool.h"
+#include "TerrainNoise.h"
 
 using namespace sf;
 
@@ -13,6 +21,18 @@ size_t screen_y();
 size_t window_x();
 size_t window_y();
 
+//World geometry in world units, independent of the display: the same seed gives
+//the same planet everywhere. The game view shows WORLD_VIEW_HEIGHT units vertically
+//and is scaled to the window (reference values are those of a 1920x1080 desktop).
+#define WORLD_VIEW_WIDTH 1620
+#define WORLD_VIEW_HEIGHT 780
+#define WORLD_WIDTH (20 * WORLD_VIEW_WIDTH)
+#define WORLD_DOWN_BORDER (5 * WORLD_VIEW_HEIGHT)
+#define WORLD_UP_BORDER (-5 * WORLD_VIEW_HEIGHT)
+#define WORLD_START_Y (WORLD_VIEW_HEIGHT - 100) //y of the leftmost sample
+
+View GameView(const RenderTarget& window, const Vector2f& center); //fixed height, width from the aspect ratio
+
 enum class Hole {
 	EMPTY_U,
 	EMPTY_V,
@@ -21,61 +41,152 @@ enum class Hole {
 	METEORITE
 };
 
+enum class Generator {
+	WALK, //sequential random walk
+	NOISE //random-access layered noise, see TerrainNoise
+};
+
+enum class Material : uint8_t {
+	ROCK,
+	LAKE,
+	ICE,
+	METEORITE
+};
+
+struct Feature { //lake, glacier, meteorite, snow piece or a batch of them
+	VertexArray vertices;
+	std::unique_ptr<VertexBuffer> buffer; //static GPU copy of vertices, nullptr if not uploaded (a copy of a VertexBuffer is a new GL buffer)
+	float left, right; //x-extent, fixed after generation
+
+	Feature(const VertexArray& v);
+	bool Overlaps(const float& x_left, const float& x_right) const;
+	void Upload();
+	void Draw(RenderTarget& window, const RenderStates& states) const;
+};
+
 class Surface {
 protected:
-	VertexArray surface;
-	std::vector<VertexArray> lakes;
-	std::vector<VertexArray> snow;
-	std::vector<VertexArray> glaciers;
-	std::vector<VertexArray> meteorites;
-	std::map<float, float> planes;
+	std::vector<float> heights; //heights[i] - y of the sample at x = left_position.x + i * x_spacing
+	std::vector<Material> materials;
+	mutable VertexArray strip; //render vertices of the visible samples, derived from heights
+	mutable VertexArray lake_frame; //animated copy of a lake when shaders are unavailable
+	float time = 0; //simulation time, drives the lake waves
+	int chunk_size = 256; //samples per render chunk, divisible by every LOD stride
+	int lod_levels = 4; //level l keeps every 4^l-th sample
+	float lod_pixels = 4; //min on-screen distance between drawn samples
+	std::vector<std::vector<std::unique_ptr<VertexBuffer>>> chunk_buffers; //[level][chunk] static strips, empty if vertex buffers are unavailable
+	std::vector<Feature> lakes;
+	std::vector<Feature> snow;
+	std::vector<Feature> glaciers;
+	std::vector<Feature> meteorites;
+	//[chunk] one triangle list per chunk and texture, built from the features starting in the chunk
+	std::vector<Feature> lake_batches;
+	std::vector<Feature> snow_batches;
+	std::vector<Feature> glacier_batches;
+	std::vector<Feature> meteorite_batches;
+	LandingSites sites;
+	std::map<int, float> undeformed; //sample -> height before the first Deform over it
 	Vector2f left_position;
 	int pixel_size;
 	int vertex_count;
-	int iter_0; //surface[iter_0].position.x = 0 (.y = down_border)
+	int iter_0; //GetVertex(iter_0).position.x = 0 (.y = down_border)
 
 	float x_spacing = 20; //space between vertexes
 	int step = 500; //generation step
-	int down_border = 5 * window_y();
-	int up_border = -5 * window_y();
+	int down_border = WORLD_DOWN_BORDER;
+	int up_border = WORLD_UP_BORDER;
 	int max_angle; //0-70
 	int rough; //0-10...
 	int snow_coverage; //0-100 %
 	std::map<Hole, int> probability;
 	int air_density;
 	int gravity;
+	unsigned int seed;
+	Generator generator;
+	const std::atomic<bool>* cancel = nullptr; //set by background builds, checked between the steps
+	bool from_cache = false;
+	Random slope_rnd; //streams of the chunk being generated
+	Random hole_rnd;
 
 	Color surface_color;
 	Color meteorites_color;
 	Color lakes_color;
 
-	Texture texture;
-	Texture ice_texture;
-	Texture meteorite_texture;
+	std::shared_ptr<const Texture> texture; //shared, never copied with the planet
 	String file;
-	Image image;
 public:
-	Surface(const String&, const int& rough, const int& snow_coverage, std::map<Hole, int>, int _max_angle, int gravity, int air_d);
-	void SetTexture();
+	Surface(const String&, const int& rough, const int& snow_coverage, std::map<Hole, int>, int _max_angle, int gravity, int air_d, unsigned int seed,
+		Generator generator = Generator::WALK, const std::atomic<bool>* cancel = nullptr);
+	//Move-only: a copy would duplicate every array and read the GPU buffers back.
+	//A move is O(1), TerrainSampler views of the planet stay valid.
+	Surface(const Surface&) = delete;
+	Surface& operator = (const Surface&) = delete;
+	Surface(Surface&&) = default;
+	Surface& operator = (Surface&&) = default;
+	//With a cancel flag the constructor only does the CPU part and may run on any thread;
+	//Finish then saves the cache file and uploads to the GPU on the render thread.
+	bool Cancelled() const;
+	void Finish();
+	static void Prefetch(const String& file); //decodes the textures of a planet, any thread
+	void PrepareRender(); //texture coordinates and batches, CPU only
+	void SetTexture(); //texture and vertex buffers, render thread
 	
 	size_t Get_VertexCount() const;
-	Vertex GetVertex(const int& i) const;
+	Vertex GetVertex(const int& i) const; //i-th vertex of the strip: even - top, odd - bottom
+	size_t GetSampleCount() const;
+	float GetSampleX(const int& i) const;
+	float GetSampleHeight(const int& i) const;
+	Material GetMaterial(const int& i) const;
+	void BuildStrip(VertexArray& out, int first, int last, int stride = 1) const; //samples [first, last)
+	void VisibleSamples(const float& x_left, const float& x_right, int& first, int& last) const;
+	int LodLevel(const RenderTarget& window) const;
+	int LodStride(const int& level) const;
+	void UploadBuffers();
+	int ChunkCount() const;
+	void ChunkFeatures(const std::vector<Feature>& features, const int& c, int& first, int& last) const; //[first, last) start in chunk c
+	Feature BuildBatch(const std::vector<Feature>& features, const int& c) const;
+	void BuildBatches();
 	int Get_iter_0() const;
 	float Get_spacing() const;
 	float YtoX(const float&);
+	TerrainSampler Sampler() const;
+	const LandingSites& GetLandingSites() const;
+	Color MaterialColor(const Material&) const;
 	int GetGravity() const;
 	int GetAirDensity() const;
+	unsigned int GetSeed() const;
+	Generator GetGenerator() const;
+	TerrainNoise Noise() const;
+
+	uint64_t CacheKey() const;
+	bool LoadCache();
+	void SaveCache();
 
 	void Generate();
+	void GenerateWalk();
+	void GenerateNoise();
+	void BuildFeature(Hole, int first, int last, const int& level); //lake, glacier or meteorite over samples [first, last)
 	void ColorGenerate();
 	void GenerateSlope(Vector2f& point, const int& x_border, const int& loc_rough, const float& angle);
 	void GenerateHole(Vector2f& point, const int& x_border, Hole);
 	void Generate_V(Vector2f& point, const float& step, const int& step_count, const int& loc_rough);
 	void Generate_U(Vector2f& point, const float& step, const int& step_count, const int& loc_rough);
 	void GenerateSnow();
+	void BuildLandingSites();
+
+	//height(x, y) gives the new y of every sample in [x_left, x_right]; only the spans
+	//of the mesh, landing sites and features over the edited samples are rebuilt
+	void Deform(const float& x_left, const float& x_right, const std::function<float(float, float)>& height);
+	void Crater(const float& x, const float& radius, const float& depth);
+	void Restore(); //undoes every Deform, the planet is as generated again
+	void RebuildSpan(const int& first, const int& last); //after samples [first, last) changed
 
+	static float WaveOffset(const float& t);
 	void Update(const float& dt);
-	void Draw(RenderWindow&) const;
+	void Draw(RenderTarget&) const;
 };
 
-void mix(std::vector<int>& v);
\ No newline at end of file
+void mix(std::vector<int>& v, Random& rnd);
+Shader* LakeShader(); //nullptr if shaders are unavailable
+const Texture& IceTexture(); //loaded once, shared by every planet
+const Texture& MeteoriteTexture();
\ No newline at end of file
@@ -0,0 +1,183 @@
+#include "Surface.h"
+#include "MappedFile.h"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstring>
+#include <cstdio>
+
+//Binary planet file: header, heights, materials, then the feature groups.
+//Every block is a plain array, so loading is a few memcpy from the mapping.
+static const char PLANET_MAGIC[4] = { 'P', 'L', 'N', 'T' };
+static const uint32_t PLANET_VERSION = 2;
+static const std::string PLANET_CACHE_DIR = "cache";
+
+struct PlanetHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t key;
+    uint32_t sample_count;
+    uint32_t surface_color;
+    uint32_t lakes_color;
+    uint32_t meteorites_color;
+    uint32_t feature_count[4]; //lakes, snow, glaciers, meteorites
+    uint64_t file_size; //a shorter or longer file is damaged
+};
+
+static void hash_bytes(uint64_t& h, const void* p, size_t n) { //FNV-1a
+    const unsigned char* bytes = static_cast<const unsigned char*>(p);
+    for (size_t i = 0; i < n; ++i) {
+        h ^= bytes[i];
+        h *= 0x100000001b3ULL;
+    }
+}
+template <typename T>
+static void hash_value(uint64_t& h, const T& value) { hash_bytes(h, &value, sizeof(value)); }
+
+uint64_t Surface::CacheKey() const {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    hash_value(h, PLANET_VERSION);
+    hash_value(h, seed);
+    hash_value(h, generator);
+    hash_value(h, rough);
+    hash_value(h, snow_coverage);
+    for (const auto& p : probability) {
+        hash_value(h, p.first);
+        hash_value(h, p.second);
+    }
+    hash_value(h, max_angle);
+    hash_value(h, gravity);
+    hash_value(h, air_density);
+    //world geometry, the same settings give another planet on another size
+    hash_value(h, pixel_size);
+    hash_value(h, x_spacing);
+    hash_value(h, step);
+    hash_value(h, down_border);
+    hash_value(h, up_border);
+    return h;
+}
+
+static std::string cache_path(uint64_t key) {
+    std::ostringstream path;
+    path << PLANET_CACHE_DIR << "/planet_" << std::hex << std::setw(16) << std::setfill('0') << key << ".bin";
+    return path.str();
+}
+
+static std::vector<Feature>* feature_groups(std::vector<Feature>& lakes, std::vector<Feature>& snow,
+    std::vector<Feature>& glaciers, std::vector<Feature>& meteorites, int i) {
+    switch (i) {
+    case 0: return &lakes;
+    case 1: return &snow;
+    case 2: return &glaciers;
+    default: return &meteorites;
+    }
+}
+
+bool Surface::LoadCache() {
+    MappedFile file(cache_path(CacheKey()));
+    if (!file.IsOpen() || file.Size() < sizeof(PlanetHeader)) {
+        return false;
+    }
+    const char* p = file.Data();
+    const char* end = p + file.Size();
+    PlanetHeader header;
+    std::memcpy(&header, p, sizeof(header));
+    p += sizeof(header);
+    if (std::memcmp(header.magic, PLANET_MAGIC, 4) != 0 || header.version != PLANET_VERSION ||
+        header.key != CacheKey() || header.file_size != file.Size()) {
+        return false;
+    }
+
+    size_t n = header.sample_count;
+    if (size_t(end - p) < n * (sizeof(float) + sizeof(Material))) {
+        return false;
+    }
+    heights.resize(n);
+    std::memcpy(heights.data(), p, n * sizeof(float));
+    p += n * sizeof(float);
+    materials.resize(n);
+    std::memcpy(materials.data(), p, n * sizeof(Material));
+    p += n * sizeof(Material);
+
+    for (int g = 0; g < 4; ++g) {
+        std::vector<Feature>& group = *feature_groups(lakes, snow, glaciers, meteorites, g);
+        group.clear();
+        std::vector<uint32_t> sizes(header.feature_count[g]);
+        if (size_t(end - p) < sizes.size() * sizeof(uint32_t)) {
+            return false;
+        }
+        std::memcpy(sizes.data(), p, sizes.size() * sizeof(uint32_t));
+        p += sizes.size() * sizeof(uint32_t);
+        for (uint32_t size : sizes) {
+            if (size_t(end - p) < size * sizeof(Vertex)) {
+                return false;
+            }
+            VertexArray vertices(TrianglesStrip, size);
+            if (size > 0) {
+                std::memcpy(&vertices[0], p, size * sizeof(Vertex));
+            }
+            p += size * sizeof(Vertex);
+            group.push_back(vertices);
+        }
+    }
+
+    if (p != end) {
+        return false;
+    }
+    surface_color = Color(header.surface_color);
+    lakes_color = Color(header.lakes_color);
+    meteorites_color = Color(header.meteorites_color);
+    BuildLandingSites();
+    PrepareRender();
+    return true;
+}
+
+void Surface::SaveCache() {
+    if (!MakeDirectory(PLANET_CACHE_DIR)) {
+        return;
+    }
+    //written aside and renamed over the old file, so a planet loading on another thread
+    //never maps a file that is half-written
+    std::string path = cache_path(CacheKey());
+    std::string temp = path + ".tmp";
+    std::ofstream fout(temp, std::ios::binary | std::ios::trunc);
+    if (!fout.is_open()) {
+        return;
+    }
+    PlanetHeader header;
+    std::memcpy(header.magic, PLANET_MAGIC, 4);
+    header.version = PLANET_VERSION;
+    header.key = CacheKey();
+    header.sample_count = heights.size();
+    header.surface_color = surface_color.toInteger();
+    header.lakes_color = lakes_color.toInteger();
+    header.meteorites_color = meteorites_color.toInteger();
+    for (int g = 0; g < 4; ++g) {
+        header.feature_count[g] = feature_groups(lakes, snow, glaciers, meteorites, g)->size();
+    }
+    header.file_size = sizeof(header) + heights.size() * sizeof(float) + materials.size() * sizeof(Material);
+    for (int g = 0; g < 4; ++g) {
+        for (const auto& feature : *feature_groups(lakes, snow, glaciers, meteorites, g)) {
+            header.file_size += sizeof(uint32_t) + feature.vertices.getVertexCount() * sizeof(Vertex);
+        }
+    }
+    fout.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    fout.write(reinterpret_cast<const char*>(heights.data()), heights.size() * sizeof(float));
+    fout.write(reinterpret_cast<const char*>(materials.data()), materials.size() * sizeof(Material));
+    for (int g = 0; g < 4; ++g) {
+        const std::vector<Feature>& group = *feature_groups(lakes, snow, glaciers, meteorites, g);
+        for (const auto& feature : group) {
+            uint32_t size = feature.vertices.getVertexCount();
+            fout.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        }
+        for (const auto& feature : group) {
+            if (feature.vertices.getVertexCount() > 0) {
+                fout.write(reinterpret_cast<const char*>(&feature.vertices[0]), feature.vertices.getVertexCount() * sizeof(Vertex));
+            }
+        }
+    }
+    fout.close();
+    if (!fout || !RenameFile(temp, path)) {
+        std::remove(temp.c_str());
+    }
+}
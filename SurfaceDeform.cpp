@@ -0,0 +1,137 @@
+#include "Surface.h"
+
+void Surface::Deform(const float& x_left, const float& x_right, const std::function<float(float, float)>& height) {
+    int first = std::max(int(ceil((x_left - left_position.x) / x_spacing)), 0);
+    int last = std::min(int(floor((x_right - left_position.x) / x_spacing)) + 1, int(heights.size()));
+    if (first >= last) {
+        return;
+    }
+    for (int i = first; i < last; ++i) {
+        undeformed.emplace(i, heights[i]); //only the first time
+        float y = height(GetSampleX(i), heights[i]);
+        heights[i] = std::min(std::max(y, float(up_border)), float(down_border - 1));
+    }
+    RebuildSpan(first, last);
+}
+
+void Surface::Crater(const float& x, const float& radius, const float& depth) {
+    //parabolic bowl with a low rim thrown out around it
+    Deform(x - 1.5f * radius, x + 1.5f * radius, [=](float sx, float y) {
+        float d = abs(sx - x) / radius;
+        if (d < 1) {
+            return y + depth * (1 - d * d); //y grows down
+        }
+        return y - 0.2f * depth * (1 - abs(d - 1.25f) / 0.25f);
+    });
+}
+
+void Surface::Restore() {
+    //every run of consecutive samples is one span
+    auto run = undeformed.begin();
+    while (run != undeformed.end()) {
+        int first = run->first, last = first;
+        for (; run != undeformed.end() && run->first == last; ++run, ++last) {
+            heights[last] = run->second;
+        }
+        RebuildSpan(first, last);
+    }
+    undeformed.clear();
+}
+
+static void update_batch(Feature& batch) {
+    if (batch.buffer && batch.buffer->getVertexCount() == batch.vertices.getVertexCount() && batch.vertices.getVertexCount() > 0) {
+        batch.buffer->update(&batch.vertices[0]);
+    }
+    else if (batch.buffer) {
+        batch.Upload();
+    }
+}
+
+void Surface::RebuildSpan(const int& first, const int& last) {
+    sites.Rebuild(heights, materials, left_position.x, x_spacing, 3 * x_spacing, first, last);
+
+    //chunk c holds samples [c * chunk_size, (c + 1) * chunk_size], the edge sample is shared
+    int c_first = std::max(first - 1, 0) / chunk_size;
+    int c_last = (last - 1) / chunk_size;
+
+    //features that follow the ground: snow lies on it, glaciers have it as their bottom edge.
+    //A feature starting one chunk to the left can reach into the span.
+    float x_left = GetSampleX(first);
+    float x_right = GetSampleX(last - 1);
+    for (int c = std::max(c_first - 1, 0); c <= c_last && c < snow_batches.size(); ++c) {
+        int f_first, f_last;
+        bool changed = false;
+        ChunkFeatures(snow, c, f_first, f_last);
+        for (int f = f_first; f < f_last; ++f) {
+            if (!snow[f].Overlaps(x_left, x_right)) {
+                continue;
+            }
+            VertexArray& v = snow[f].vertices;
+            int i0 = int(round((v[0].position.x - left_position.x) / x_spacing));
+            for (int j = 0; j + 1 < v.getVertexCount(); j += 2) {
+                v[j].position.y = heights[i0 + j / 2];
+                v[j + 1].position.y = v[j].position.y + 50;
+            }
+            changed = true;
+        }
+        ChunkFeatures(glaciers, c, f_first, f_last);
+        bool glacier_changed = false;
+        for (int f = f_first; f < f_last; ++f) {
+            if (!glaciers[f].Overlaps(x_left, x_right)) {
+                continue;
+            }
+            VertexArray& v = glaciers[f].vertices;
+            int i0 = int(round((v[1].position.x - left_position.x) / x_spacing));
+            for (int j = 1; j < v.getVertexCount(); j += 2) {
+                v[j].position.y = heights[i0 + j / 2];
+                v[j].texCoords = v[j].position;
+            }
+            glacier_changed = true;
+        }
+        //a meteorite rests on the ground: each sample's pair moves with it, the ends with the nearest pair
+        ChunkFeatures(meteorites, c, f_first, f_last);
+        bool meteorite_changed = false;
+        for (int f = f_first; f < f_last; ++f) {
+            VertexArray& v = meteorites[f].vertices;
+            if (!meteorites[f].Overlaps(x_left, x_right) || v.getVertexCount() < 4) {
+                continue;
+            }
+            int n = v.getVertexCount();
+            int i0 = int(round((v[1].position.x - left_position.x) / x_spacing));
+            float dy = 0;
+            for (int j = 1; j + 1 < n; j += 2) {
+                dy = heights[i0 + j / 2] - v[j].position.y;
+                v[j].position.y += dy; //bottom
+                v[j + 1].position.y += dy; //top
+                if (j == 1) {
+                    v[0].position.y += dy;
+                }
+            }
+            v[n - 1].position.y += dy;
+            meteorite_changed = true;
+        }
+        if (changed) {
+            snow_batches[c].vertices = BuildBatch(snow, c).vertices; //the x-extent and buffer stay
+            update_batch(snow_batches[c]);
+        }
+        if (glacier_changed) {
+            glacier_batches[c].vertices = BuildBatch(glaciers, c).vertices;
+            update_batch(glacier_batches[c]);
+        }
+        if (meteorite_changed) {
+            meteorite_batches[c].vertices = BuildBatch(meteorites, c).vertices;
+            update_batch(meteorite_batches[c]);
+        }
+    }
+
+    if (chunk_buffers.empty()) {
+        return; //the fallback strip is derived from heights every frame
+    }
+    VertexArray chunk;
+    for (int level = 0; level < lod_levels; ++level) {
+        for (int c = c_first; c <= c_last && c < chunk_buffers[level].size(); ++c) {
+            BuildStrip(chunk, c * chunk_size, (c + 1) * chunk_size + 1, LodStride(level));
+            chunk_buffers[level][c]->update(&chunk[0]); //same vertex count, updated in place
+        }
+    }
+}
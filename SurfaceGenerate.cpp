@@ -1,56 +1,80 @@
 #include "Surface.h"
 
 void Surface::Generate() {
-    surface.clear();
+    heights.clear();
+    materials.clear();
     lakes.clear();
     glaciers.clear();
+    meteorites.clear();
+    snow.clear();
+    if (generator == Generator::NOISE) {
+        GenerateNoise();
+    }
+    else {
+        GenerateWalk();
+    }
+    if (Cancelled()) {
+        return;
+    }
+    GenerateSnow();
+    BuildLandingSites();
+    ColorGenerate();
+    PrepareRender();
+}
+
+void Surface::GenerateWalk() {
     Vector2f point = left_position;
 
     float angle = 0;
     float prev_angle = 0;
-    while (point.x < left_position.x + pixel_size) {
+    uint32_t chunk = 0; //one loop pass = one chunk with its own random streams
+    while (point.x < left_position.x + pixel_size && !Cancelled()) {
+        Random rnd(seed, chunk, Stream::TERRAIN);
+        slope_rnd = Random(seed, chunk, Stream::SLOPE);
+        hole_rnd = Random(seed, chunk, Stream::HOLE);
+        ++chunk;
         int down_turn_border = down_border - tan(max_angle) * 6 * step;   //down y from which U-turn starts
         int up_turn_border = up_border + tan(max_angle) * 4 * step;       //up y from which U-turn starts
         if (point.y > down_turn_border) {
-            angle = rand() % 50 + 10;
+            angle = rnd(50) + 10;
         }
         else if (point.y < up_turn_border) {
-            angle = rand() % 50 - 60;
+            angle = rnd(50) - 60;
         }
         else {
-            angle = rand() % (max_angle * 2 + 1) - max_angle;
+            angle = rnd(max_angle * 2 + 1) - max_angle;
         }
         if (abs(angle - prev_angle) > 0) {
             GenerateSlope(point, point.x + step / 6, 2 * rough, (prev_angle + (angle - prev_angle) / 3));
             GenerateSlope(point, point.x + step / 6, 2 * rough, (prev_angle + 2 * (angle - prev_angle) / 3));
         }
         prev_angle = angle;
-        int rand_rough = ((rand() % 3) + 1) * rough;
+        int rand_rough = (rnd(3) + 1) * rough;
         GenerateSlope(point, point.x + step, rand_rough, angle);
-        float size = (rand() % 19+1.0) / 10;
-        switch (rand() % 5) {
+        float size = (rnd(19) + 1.0) / 10;
+        switch (rnd(5)) {
         case 0:
-            if (rand() % 100 < probability[Hole::LAKE]) {
+            if (rnd(100) < probability[Hole::LAKE]) {
                 GenerateHole(point, point.x + size*step, Hole::LAKE);
             }
             break;
         case 1:
-            if (rand() % 100 < probability[Hole::ICE]) {
+            if (rnd(100) < probability[Hole::ICE]) {
                 GenerateHole(point, point.x + size*step, Hole::ICE);
             }
             break;
         case 2:
-            if (rand() % 100 < probability[Hole::METEORITE]) {
+            if (rnd(100) < probability[Hole::METEORITE]) {
                 GenerateHole(point, point.x + size*step / 2, Hole::METEORITE);
             }
             break;
         case 3:
-            if (rand() % 100 < probability[Hole::EMPTY_U]) {
+            if (rnd(100) < probability[Hole::EMPTY_U]) {
                 GenerateHole(point, point.x + size*step / 2, Hole::EMPTY_U);
             }
             break;
         case 4:
-            if (rand() % 100 < probability[Hole::EMPTY_V]) {
+            if (rnd(100) < probability[Hole::EMPTY_V]) {
                 GenerateHole(point, point.x + size*step, Hole::EMPTY_V);
             }
             break;           
@@ -58,21 +82,52 @@ void Surface::Generate() {
             break;
         }
         //FLAT
-        if (rand() % 100 < 20) {
+        if (rnd(100) < 20) {
             int angle = 0;
-            planes[point.x] = point.x + step * size;
             GenerateSlope(point, point.x + step*size, rough*0, angle);
         }
-        //GenerateSlope(point, point.x + step, rand_rough, rand() % 30);
+        //GenerateSlope(point, point.x + step, rand_rough, rnd(30));
+    }
+}
+
+TerrainNoise Surface::Noise() const {
+    return TerrainNoise(seed, rough, max_angle, probability, step, x_spacing, left_position.x,
+        left_position.y, up_border + step, down_border - step);
+}
+
+void Surface::GenerateNoise() {
+    TerrainNoise noise = Noise();
+    int count = vertex_count;
+    heights.resize(count);
+    materials.assign(count, Material::ROCK);
+    Workers().ParallelFor(0, count, 1024, [&](int first, int last) {
+        for (int i = first; i < last; ++i) {
+            heights[i] = noise.Height(GetSampleX(i));
+        }
+    });
+
+    int cell_count = noise.Cell(GetSampleX(count - 1)) + 1;
+    HoleCell hole;
+    for (int c = 0; c < cell_count; ++c) {
+        if (!noise.HoleAt(c, hole)) {
+            continue;
+        }
+        int first = std::max(int(ceil((hole.left - left_position.x) / x_spacing)), 0);
+        int last = std::min(int(ceil((hole.right - left_position.x) / x_spacing)), count);
+        if (last - first < 5) {
+            continue;
+        }
+        hole_rnd = Random(seed, c, Stream::HOLE);
+        hole_rnd.Seek(4); //0-3 are taken by HoleAt
+        int level = std::max(heights[first], heights[last - 1]); //lower rim
+        BuildFeature(hole.type, first, last, level);
     }
-    GenerateSnow();
-    ColorGenerate();
-    SetTexture();
 }
 
 void Surface::ColorGenerate() {
+    Random rnd(seed, 0, Stream::COLOR);
     //***SURFACE__COLOR***//
-    switch (rand() % 17) {
+    switch (rnd(17)) {
     case 0:
         surface_color = Color(0xb00000ff); //dark red
         break;
@@ -126,7 +181,7 @@ void Surface::ColorGenerate() {
         break;
     }
     //***LAKES__COLOR***//
-    switch (rand() % 4) {
+    switch (rnd(4)) {
     case 0:
         lakes_color = Color(0x30c25ad0); //green
         break;
@@ -141,7 +196,7 @@ void Surface::ColorGenerate() {
         break;
     }
     //***METEORITES__COLOR***//
-    switch (rand() % 5) {
+    switch (rnd(5)) {
     case 0:
         meteorites_color = Color(0xb00000ff); //dark red
         break;
@@ -163,10 +218,10 @@ void Surface::ColorGenerate() {
 void Surface::Generate_V(Vector2f& point, const float& step, const int& step_count, const int& loc_rough) {
     std::vector<int> angles(step_count);
     for (auto& angle : angles) {
-        angle = rand() % (60) + 10;
+        angle = hole_rnd(60) + 10;
         GenerateSlope(point, point.x + step, loc_rough, -angle);
     }
-    mix(angles);
+    mix(angles, hole_rnd);
     for (const auto& angle : angles) {
         GenerateSlope(point, point.x + step, loc_rough, angle);
     }
@@ -179,7 +234,7 @@ void Surface::Generate_U(Vector2f& point, const float& step, const int& step_cou
         angles[i] = i * a_step;
         GenerateSlope(point, point.x + step, loc_rough, -angles[i]);
     }
-    //mix(angles);
+    //mix(angles, hole_rnd);
     for (const auto& angle : angles) {
         GenerateSlope(point, point.x + step, loc_rough, angle);
     }
@@ -191,7 +246,7 @@ void Surface::GenerateHole(Vector2f& point, const int& x_border, Hole h) {
     float length = x_border - point.x;
     float step = length / (2 * step_count + 2);
     GenerateSlope(point, point.x + step, rough, 40);    //ascent before hole
-    int iter = surface.getVertexCount();
+    int iter = heights.size();
 
     switch (h) {
     case Hole::EMPTY_V:
@@ -208,9 +263,15 @@ void Surface::GenerateHole(Vector2f& point, const int& x_border, Hole h) {
         break;
     }
 
-    int hole_border = surface.getVertexCount();
+    int hole_border = heights.size();
     GenerateSlope(point, point.x + step, rough, -40);   //descent before hole
 
+    BuildFeature(h, iter, hole_border, level);
+}
+
+void Surface::BuildFeature(Hole h, int first, int last, const int& level) {
+    int iter = first;
+    int hole_border = last;
     switch (h) {
     case Hole::EMPTY_V:
     case Hole::EMPTY_U:
@@ -221,10 +282,10 @@ void Surface::GenerateHole(Vector2f& point, const int& x_border, Hole h) {
         lake.setPrimitiveType(TrianglesStrip);
         Vector2f v1, v2;
         while (iter < hole_border) {
-            v2 = Vector2f(surface[iter].position.x, level + rand() % 3 + 20);
+            materials[iter] = Material::LAKE;
+            v2 = Vector2f(GetSampleX(iter), level + hole_rnd(3) + 20);
             lake.append(Vertex(v2, Color::Blue));
-            ++iter;
-            v1 = Vector2f(surface[iter].position.x, surface[iter].position.y);
+            v1 = Vector2f(GetSampleX(iter), down_border);
             lake.append(Vertex(v1, Color::Blue));
             ++iter;
         }
@@ -236,23 +297,24 @@ void Surface::GenerateHole(Vector2f& point, const int& x_border, Hole h) {
         VertexArray glacier;
         glacier.setPrimitiveType(TrianglesStrip);
         Vector2f v1;
-        Vector2f v2 = Vector2f(surface[iter].position.x, level);
+        Vector2f v2 = Vector2f(GetSampleX(iter), level);
         int mid_iter = (hole_border + iter) / 2;
-        int slope = rand() % 20 + 20;
+        int slope = hole_rnd(20) + 20;
         int dy;
         while (iter < hole_border) {
-            dy = rand() % slope / 10.0 * x_spacing;
+            materials[iter] = Material::ICE;
+            dy = hole_rnd(slope) / 10.0 * x_spacing;
             if (iter < mid_iter) {
                 v2.y -= dy;
             }
             else {
                 v2.y += dy;
             }
-            v2.x = surface[iter].position.x;
+            v2.x = GetSampleX(iter);
             glacier.append(Vertex(v2, Color::White)); //top
-            v1 = Vector2f(surface[iter].position); //bottom
+            v1 = Vector2f(GetSampleX(iter), heights[iter]); //bottom
             glacier.append(Vertex(v1, Color::White));
-            iter += 2;
+            ++iter;
         }
         //smoothing
         int Count = glacier.getVertexCount();
@@ -271,15 +333,16 @@ void Surface::GenerateHole(Vector2f& point, const int& x_border, Hole h) {
     {
         VertexArray meteorite;
         meteorite.setPrimitiveType(TrianglesStrip);
-        Vector2f v = surface[iter].position;
+        Vector2f v(GetSampleX(iter), heights[iter]);
         float mid_level = v.y;
         meteorite.append(Vertex({ v.x + x_spacing / 2, mid_level }, Color::Cyan));
-        iter += 2;
+        materials[iter] = Material::METEORITE;
+        ++iter;
         while (iter < hole_border) {
-            v = surface[iter].position;
+            materials[iter] = Material::METEORITE;
+            v = Vector2f(GetSampleX(iter), heights[iter]);
             meteorite.append(Vertex(v, Color::Cyan));
-            ++iter;
-            v.y = -v.y + 2 * mid_level + rand() % 10 - 5;
+            v.y = -v.y + 2 * mid_level + hole_rnd(10) - 5;
             meteorite.append(Vertex(v, Color::Cyan));
             ++iter;
         }
@@ -291,35 +354,47 @@ void Surface::GenerateHole(Vector2f& point, const int& x_border, Hole h) {
 }
 
 void Surface::GenerateSnow() {
-    int i = 0;
-    int piece_lengh = 50;
-    while (i + 2 < surface.getVertexCount()) {
-        if (rand() % 100 < snow_coverage) {
-            VertexArray snow_piece;
+    //pieces lie on a fixed grid and share their edge sample, so each one is decided
+    //and built independently of the others
+    const int piece_lengh = 50;
+    const int piece_step = piece_lengh - 1;
+    int count = heights.size();
+    int piece_count = count > 1 ? (count - 2) / piece_step + 1 : 0;
+    Random rnd(seed, 0, Stream::SNOW);
+    std::vector<VertexArray> pieces(piece_count);
+    Workers().ParallelFor(0, piece_count, 16, [&](int first, int last) {
+        for (int p = first; p < last; ++p) {
+            int i = p * piece_step;
+            if (Bounded(rnd.At(i), 100) >= snow_coverage) { //keyed by sample, not by call order
+                continue;
+            }
+            VertexArray& snow_piece = pieces[p];
             snow_piece.setPrimitiveType(TrianglesStrip);
-            for (int j = 0; i < surface.getVertexCount() && j < piece_lengh; ++j) {
-                Vector2f point = surface[i].position;
+            for (int j = 0; i < count && j < piece_lengh; ++j, ++i) {
+                Vector2f point(GetSampleX(i), heights[i]);
                 snow_piece.append(Vertex(point, Color::White));
                 point.y += 50;
                 snow_piece.append(Vertex(point, Color::Transparent));
-                i += 2;
             }
-            snow.push_back(snow_piece);
-            i -= 2;
         }
-        else {
-            i += 2 * piece_lengh;
+    });
+    for (const auto& snow_piece : pieces) {
+        if (snow_piece.getVertexCount() > 0) {
+            snow.push_back(snow_piece);
         }
     }
 }
 
 void Surface::GenerateSlope(Vector2f& point, const int& x_border, const int& loc_rough, const float& angle) {
-    while (point.x < x_border) {
+    int count = point.x < x_border ? int(ceil((x_border - point.x) / x_spacing)) : 0;
+    std::vector<uint32_t> r(2 * count + 2); //two numbers per step, drawn in one block
+    slope_rnd.Fill(r);
+    for (int i = 0; point.x < x_border; i += 2) {
         float slope_direction = 0;
-        surface.append(Vertex(point, Color::White));
-        surface.append(Vertex(Vector2f(point.x, down_border), Color::White));
-        if (rand() % 100 < 50) {
-            slope_direction = ((float)(rand() % 100)) / 100.0 - 0.5f;
+        heights.push_back(point.y);
+        materials.push_back(Material::ROCK);
+        if (Bounded(r[i], 100) < 50) {
+            slope_direction = ((float)Bounded(r[i + 1], 100)) / 100.0 - 0.5f;
         }
         point.x += x_spacing;
         point.y += (float)(loc_rough)*slope_direction;
@@ -0,0 +1,115 @@
+#include "TerrainNoise.h"
+#include "Surface.h"
+#include <algorithm>
+#include <cmath>
+
+static const float NOISE_MAX_SLOPE = 2.7f; //max |d Layer / du|, bounds the slope of every layer
+const int TerrainNoise::OCTAVES;
+
+TerrainNoise::TerrainNoise(uint32_t _seed, const int& rough, const int& max_angle, const std::map<Hole, int>& prob,
+	const float& _step, const float& spacing, const float& _origin_x, const float& _base_y,
+	const float& _top, const float& _bottom)
+	: seed(_seed), origin_x(_origin_x), base_y(_base_y), top(_top), bottom(_bottom), cell_width(2 * _step),
+	step(_step), x_spacing(spacing), probability(prob) {
+	rough_amp = rough / 2.f; //same swing per sample as the random walk
+	rough_wavelength = 2 * x_spacing;
+	warp_amp = step / 2;
+	warp_wavelength = 6 * step;
+	fbm_wavelength = 16 * step;
+	ridge_wavelength = 4 * step;
+
+	//every layer's slope is bounded by amplitude * NOISE_MAX_SLOPE / wavelength, so the
+	//amplitudes are chosen to keep the sum under max_angle. Rough noise comes on top,
+	//as in the random walk.
+	float budget = tan(RAD * std::min(std::max(max_angle, 0), 70));
+	budget /= 1 + warp_amp * NOISE_MAX_SLOPE / warp_wavelength;
+	//fBm: amplitude and wavelength halve together, each octave takes the same share
+	fbm_amp = 0.7f * budget * fbm_wavelength / (OCTAVES * NOISE_MAX_SLOPE);
+	//(1 - |n|)^2 has twice the slope of n
+	ridge_amp = 0.3f * budget * ridge_wavelength / (2 * NOISE_MAX_SLOPE);
+}
+
+float TerrainNoise::Gradient(const int64_t& lattice, const uint64_t& key) {
+	return Random::Squares(uint64_t(lattice), key) * (2.f / 4294967296.f) - 1;
+}
+
+float TerrainNoise::Layer(const float& u, const int& layer) const {
+	uint64_t key = Random::MakeKey(seed, layer, Stream::NOISE);
+	float f = floor(u);
+	int64_t i = int64_t(f);
+	float t = u - f;
+	float d0 = Gradient(i, key) * t;
+	float d1 = Gradient(i + 1, key) * (t - 1);
+	float fade = t * t * t * (t * (t * 6 - 15) + 10);
+	return 2 * (d0 + (d1 - d0) * fade);
+}
+
+float TerrainNoise::Base(const float& x) const {
+	float w = x + warp_amp * Layer(x / warp_wavelength, OCTAVES + 1);
+	float h = 0;
+	float amp = fbm_amp;
+	float wavelength = fbm_wavelength;
+	for (int o = 0; o < OCTAVES; ++o) {
+		h += amp * Layer(w / wavelength, o);
+		amp /= 2;
+		wavelength /= 2;
+	}
+	float ridge = 1 - abs(Layer(w / ridge_wavelength, OCTAVES));
+	h -= ridge_amp * ridge * ridge; //y grows down, ridges point up
+	return base_y + h;
+}
+
+float TerrainNoise::HoleRough(const Hole& h) const {
+	switch (h) {
+	case Hole::LAKE:
+		return 0;
+	case Hole::EMPTY_V:
+		return 2;
+	case Hole::ICE:
+		return 5;
+	default:
+		return 3;
+	}
+}
+
+float TerrainNoise::Height(const float& x) const {
+	float h = Base(x);
+	float rough_k = 1;
+	HoleCell hole;
+	if (HoleAt(Cell(x), hole) && x > hole.left && x < hole.right) {
+		float s = 2 * (x - hole.left) / (hole.right - hole.left) - 1;
+		float profile = hole.type == Hole::EMPTY_U || hole.type == Hole::METEORITE ? 1 - s * s * s * s : 1 - abs(s);
+		h += hole.depth * profile;
+		rough_k += (HoleRough(hole.type) - 1) * profile;
+	}
+	h += rough_k * rough_amp * Layer(x / rough_wavelength, OCTAVES + 2);
+	return std::min(std::max(h, top), bottom);
+}
+
+int TerrainNoise::Cell(const float& x) const {
+	return int(floor((x - origin_x) / cell_width));
+}
+
+float TerrainNoise::CellWidth() const {
+	return cell_width;
+}
+
+bool TerrainNoise::HoleAt(const int& cell, HoleCell& out) const {
+	//the same draws as one step of the random walk, but keyed by the cell
+	Random rnd(seed, uint32_t(cell), Stream::HOLE);
+	static const Hole types[5] = { Hole::LAKE, Hole::ICE, Hole::METEORITE, Hole::EMPTY_U, Hole::EMPTY_V };
+	out.type = types[Bounded(rnd.At(0), 5)];
+	auto p = probability.find(out.type);
+	if (p == probability.end() || Bounded(rnd.At(1), 100) >= p->second) {
+		return false;
+	}
+	float width = (Bounded(rnd.At(2), 19) + 1) / 10.f * step;
+	if (out.type == Hole::METEORITE || out.type == Hole::EMPTY_U) {
+		width /= 2;
+	}
+	width = std::min(std::max(width, 12 * x_spacing), 0.8f * cell_width);
+	out.left = origin_x + cell * cell_width + Bounded(rnd.At(3), int(cell_width - width));
+	out.right = out.left + width;
+	out.depth = (out.type == Hole::EMPTY_U || out.type == Hole::METEORITE ? 0.3f : 0.4f) * width;
+	return true;
+}
\ No newline at end of file
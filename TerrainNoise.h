@@ -0,0 +1,46 @@
+#pragma once
+#include <map>
+#include <cstdint>
+
+enum class Hole;
+
+struct HoleCell {
+	Hole type;
+	float left, right; //x-extent of the hole
+	float depth;
+};
+
+//Height of the ground at any x in O(1): domain-warped fBm plus a ridged layer,
+//fine rough noise and one optional hole per cell. Nothing depends on the samples
+//to the left, so the planet can be evaluated lazily, in parallel and in any order.
+class TerrainNoise {
+private:
+	uint32_t seed;
+	float origin_x;
+	float base_y;
+	float top, bottom; //heights are kept inside
+	float cell_width;
+	float step;
+	float x_spacing;
+	float fbm_amp, fbm_wavelength;
+	float ridge_amp, ridge_wavelength;
+	float warp_amp, warp_wavelength;
+	float rough_amp, rough_wavelength;
+	std::map<Hole, int> probability;
+
+	static float Gradient(const int64_t& lattice, const uint64_t& key); //[-1, 1]
+	float Layer(const float& x, const int& layer) const; //gradient noise, about [-1, 1]
+	float HoleRough(const Hole& h) const; //rough multiplier inside a hole
+public:
+	static const int OCTAVES = 4;
+
+	TerrainNoise(uint32_t seed, const int& rough, const int& max_angle, const std::map<Hole, int>& probability,
+		const float& step, const float& x_spacing, const float& origin_x, const float& base_y,
+		const float& top, const float& bottom);
+
+	float Base(const float& x) const; //without holes
+	float Height(const float& x) const;
+	int Cell(const float& x) const;
+	float CellWidth() const;
+	bool HoleAt(const int& cell, HoleCell& out) const; //false if the cell has no hole
+};
\ No newline at end of file
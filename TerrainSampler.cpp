@@ -0,0 +1,51 @@
+#include "TerrainSampler.h"
+#include <algorithm>
+#include <cmath>
+
+TerrainSampler::TerrainSampler(const float* h, const int& n, const float& left, const float& s)
+	: heights(h), count(n), left_x(left), spacing(s), inv_spacing(1 / s) {}
+
+void TerrainSampler::Locate(const float& x, int& i, float& t) const {
+	//clamping instead of branching on the planet edges
+	float u = std::min(std::max((x - left_x) * inv_spacing, 0.f), float(count - 1));
+	i = std::min(int(u), std::max(count - 2, 0));
+	t = u - i;
+}
+
+float TerrainSampler::Height(const float& x) const {
+	if (count < 2) { return count == 1 ? heights[0] : 0; }
+	int i;
+	float t;
+	Locate(x, i, t);
+	return heights[i] + (heights[i + 1] - heights[i]) * t;
+}
+
+float TerrainSampler::Slope(const float& x) const {
+	if (count < 2) { return 0; }
+	int i;
+	float t;
+	Locate(x, i, t);
+	return (heights[i + 1] - heights[i]) * inv_spacing;
+}
+
+Vector2f TerrainSampler::Normal(const float& x) const {
+	float k = Slope(x);
+	float inv_length = 1 / sqrt(1 + k * k);
+	return Vector2f(k * inv_length, -inv_length);
+}
+
+float TerrainSampler::Altitude(const Vector2f& point) const {
+	return Height(point.x) - point.y;
+}
+
+void TerrainSampler::Heights(const float* x, float* out, const size_t& n) const {
+	for (size_t j = 0; j < n; ++j) { out[j] = Height(x[j]); }
+}
+
+void TerrainSampler::Slopes(const float* x, float* out, const size_t& n) const {
+	for (size_t j = 0; j < n; ++j) { out[j] = Slope(x[j]); }
+}
+
+void TerrainSampler::Normals(const float* x, Vector2f* out, const size_t& n) const {
+	for (size_t j = 0; j < n; ++j) { out[j] = Normal(x[j]); }
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+
+using namespace sf;
+
+//Read-only view of a heightfield with O(1) queries at any x.
+//Outside the planet the edge samples are extended, nothing throws.
+//The view is invalidated when the Surface it came from is regenerated or moved.
+class TerrainSampler {
+private:
+	const float* heights;
+	int count;
+	float left_x;
+	float spacing;
+	float inv_spacing;
+
+	void Locate(const float& x, int& i, float& t) const; //segment [i, i + 1] and position t in it
+public:
+	TerrainSampler(const float* heights, const int& count, const float& left_x, const float& spacing);
+
+	float Height(const float& x) const;
+	float Slope(const float& x) const; //dy/dx, y grows down
+	Vector2f Normal(const float& x) const; //unit, away from the ground
+	float Altitude(const Vector2f& point) const; //above the ground, negative under it
+
+	void Heights(const float* x, float* out, const size_t& n) const;
+	void Slopes(const float* x, float* out, const size_t& n) const;
+	void Normals(const float* x, Vector2f* out, const size_t& n) const;
+};
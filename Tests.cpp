@@ -17,7 +17,7 @@ void test_B2() {
                             { Hole::METEORITE, 50 }
     };
 
-    Surface s("surface.png", 20, 50, p, 70, 100, 50);
+    Surface s("surface.png", 20, 50, p, 70, 100, 50, 1);
     float time = 0;
     float dt = 0;
     Clock deltaTime;
@@ -25,10 +25,7 @@ void test_B2() {
     RickAndMorty lander(Vector2f(0, s.YtoX(200) - 500));
     lander.AddMainForces(100);
 
-    View view;
-
-    view.setCenter(sf::Vector2f(window_x() / 2, window_y() / 2));
-    view.setSize(sf::Vector2f(window_x(), window_y()));
+    View view = GameView(window, lander.GetCenterPosition());
 
 
     while (window.isOpen())
@@ -58,7 +55,7 @@ void test_B2() {
 
         lander.draw_all(window, true, true, false, true, true);
 
-        view.setCenter(lander.GetCenterPosition());
+        view = GameView(window, lander.GetCenterPosition());
         window.setView(view);
 
         s.Draw(window);
@@ -0,0 +1,31 @@
+#include "TextBatch.h"
+
+void TextBatch::Add(const SdfText& text) {
+	Add(text, { 0, 0 });
+}
+
+void TextBatch::Add(const SdfText& text, const Vector2f& offset) {
+	Vector2f p = text.GetPosition() + offset;
+	for (Vertex v : text.GetQuads()) {
+		v.position += p;
+		vertices.push_back(v);
+	}
+}
+
+void TextBatch::Clear() {
+	vertices.clear();
+}
+
+bool TextBatch::IsEmpty() const {
+	return vertices.empty();
+}
+
+void TextBatch::Draw(RenderTarget& target, RenderStates states) const {
+	if (vertices.empty()) {
+		return;
+	}
+	const SdfFont& font = UiFont();
+	states.texture = &font.GetTexture();
+	states.shader = font.GetShader();
+	target.draw(&vertices[0], vertices.size(), Triangles, states);
+}
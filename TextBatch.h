@@ -0,0 +1,18 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "SdfText.h"
+
+using namespace sf;
+
+//Collects texts into one triangle list, drawn with one call on the SDF font texture.
+class TextBatch {
+private:
+	std::vector<Vertex> vertices;
+public:
+	void Add(const SdfText& text);
+	void Add(const SdfText& text, const Vector2f& offset); //moved by offset as well
+	void Clear();
+	bool IsEmpty() const;
+	void Draw(RenderTarget& target, RenderStates states = RenderStates::Default) const;
+};
@@ -0,0 +1,83 @@
+#include "TextureAtlas.h"
+#include "AssetPack.h"
+#include "ResourceCache.h"
+#include <algorithm>
+
+TextureAtlas::TextureAtlas(const int& size, const int& max) : page_size(size), max_image(max) {}
+
+bool TextureAtlas::Place(const Vector2u& size, Page*& page, Vector2i& position) {
+	int w = size.x + 2 * padding;
+	int h = size.y + 2 * padding;
+	if (!pages.empty()) {
+		Page& last = pages.back();
+		if (last.x + w > page_size) { //next shelf
+			last.x = 0;
+			last.y += last.shelf_height;
+			last.shelf_height = 0;
+		}
+		if (last.y + h <= page_size) {
+			page = &last;
+			position = Vector2i(last.x + padding, last.y + padding);
+			last.x += w;
+			last.shelf_height = std::max(last.shelf_height, h);
+			return true;
+		}
+	}
+	Page fresh;
+	fresh.texture.reset(new Texture());
+	if (!fresh.texture->create(page_size, page_size)) {
+		return false;
+	}
+	Image clear;
+	clear.create(page_size, page_size, Color::Transparent);
+	fresh.texture->update(clear);
+	pages.push_back(std::move(fresh));
+	page = &pages.back();
+	position = Vector2i(padding, padding);
+	page->x = w;
+	page->shelf_height = h;
+	return true;
+}
+
+bool TextureAtlas::Find(const std::string& path, const bool& mask_black, AtlasRegion& out) {
+	std::lock_guard<std::mutex> lock(mutex);
+	std::string key = path + (mask_black ? "|mask" : "");
+	auto it = regions.find(key);
+	if (it != regions.end()) {
+		out = it->second;
+		return out.texture != nullptr;
+	}
+	AtlasRegion region; //stays empty if the image doesn't go to the atlas
+	const AssetEntry* packed = Assets().Find(path, AssetType::IMAGE);
+	if (!packed || (int(packed->a) <= max_image && int(packed->b) <= max_image)) { //big packed images aren't copied at all
+		std::shared_ptr<const Image> decoded = DecodeImage(path, true); //LoadTexture gets it if it's too big
+		Vector2u size = decoded->getSize();
+		Page* page;
+		Vector2i position;
+		if (size.x > 0 && int(size.x) <= max_image && int(size.y) <= max_image && Place(size, page, position)) {
+			if (mask_black) {
+				Image image = *decoded;
+				image.createMaskFromColor(Color(0, 0, 0));
+				page->texture->update(image, position.x, position.y);
+			}
+			else {
+				page->texture->update(*decoded, position.x, position.y);
+			}
+			region.texture = page->texture.get();
+			region.rect = IntRect(position.x, position.y, size.x, size.y);
+			ForgetImage(path);
+		}
+	}
+	regions[key] = region;
+	out = region;
+	return region.texture != nullptr;
+}
+
+size_t TextureAtlas::PageCount() const {
+	return pages.size();
+}
+
+TextureAtlas& Atlas() {
+	static TextureAtlas atlas(std::min(2048u, Texture::getMaximumSize()), 1024);
+	return atlas;
+}
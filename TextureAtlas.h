@@ -0,0 +1,40 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <string>
+
+using namespace sf;
+
+struct AtlasRegion {
+	const Texture* texture = nullptr; //atlas page, lives as long as the process
+	IntRect rect; //the image on the page
+};
+
+//Packs small images into a few large textures as they are first requested (shelf packing),
+//so sprites of different images can be drawn with one texture bind.
+class TextureAtlas {
+private:
+	struct Page {
+		std::unique_ptr<Texture> texture;
+		int x = 0, y = 0; //free position on the current shelf
+		int shelf_height = 0;
+	};
+	std::vector<Page> pages;
+	std::map<std::string, AtlasRegion> regions;
+	std::mutex mutex;
+	int page_size;
+	int max_image; //bigger images keep their own texture
+	int padding = 2; //transparent border, nothing bleeds in from the neighbours
+
+	bool Place(const Vector2u& size, Page*& page, Vector2i& position);
+public:
+	TextureAtlas(const int& page_size, const int& max_image);
+	//false if the image is too big or can't be loaded
+	bool Find(const std::string& path, const bool& mask_black, AtlasRegion& out);
+	size_t PageCount() const;
+};
+
+TextureAtlas& Atlas(); //process-wide atlas of 2048x2048 pages
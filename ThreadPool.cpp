@@ -0,0 +1,98 @@
+#include "ThreadPool.h"
+#include <atomic>
+#include <memory>
+#include <algorithm>
+
+ThreadPool::ThreadPool(unsigned int count) {
+	for (unsigned int i = 0; i < count; ++i) {
+		workers.emplace_back(&ThreadPool::Work, this);
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stop = true;
+	}
+	wake.notify_all();
+	for (auto& worker : workers) {
+		worker.join();
+	}
+}
+
+void ThreadPool::Work() {
+	while (true) {
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			wake.wait(lock, [this] { return stop || !tasks.empty(); });
+			if (tasks.empty()) {
+				return;
+			}
+			task = std::move(tasks.front());
+			tasks.pop_front();
+		}
+		task();
+	}
+}
+
+void ThreadPool::Push(std::function<void()> task) {
+	if (workers.empty()) {
+		task();
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		tasks.push_back(std::move(task));
+	}
+	wake.notify_one();
+}
+
+struct ForState { //shared with the helpers, which may start after ParallelFor returned
+	std::atomic<int> next{ 0 };
+	std::atomic<int> done{ 0 };
+	int count;
+	std::mutex mutex;
+	std::condition_variable finished;
+};
+
+void ThreadPool::ParallelFor(int begin, int end, int grain, const std::function<void(int, int)>& body) {
+	if (end <= begin) {
+		return;
+	}
+	grain = std::max(grain, 1);
+	int count = (end - begin + grain - 1) / grain;
+	if (count == 1 || workers.empty()) {
+		body(begin, end);
+		return;
+	}
+	auto state = std::make_shared<ForState>();
+	state->count = count;
+	const std::function<void(int, int)>* f = &body;
+	auto run = [state, f, begin, end, grain]() {
+		int r;
+		while ((r = state->next++) < state->count) { //claim ranges until none are left
+			(*f)(begin + r * grain, std::min(begin + (r + 1) * grain, end));
+			if (++state->done == state->count) {
+				std::lock_guard<std::mutex> lock(state->mutex);
+				state->finished.notify_all();
+			}
+		}
+	};
+	int helpers = std::min<int>(count - 1, workers.size());
+	for (int i = 0; i < helpers; ++i) {
+		Push(run);
+	}
+	run();
+	std::unique_lock<std::mutex> lock(state->mutex);
+	state->finished.wait(lock, [&state] { return state->done == state->count; });
+}
+
+size_t ThreadPool::Size() const {
+	return workers.size();
+}
+
+ThreadPool& Workers() {
+	static ThreadPool pool(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+	return pool;
+}
\ No newline at end of file
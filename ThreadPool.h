@@ -0,0 +1,32 @@
+#pragma once
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <vector>
+#include <deque>
+
+//Fixed set of worker threads. CPU work only - GL calls stay on the render thread.
+class ThreadPool {
+private:
+	std::vector<std::thread> workers;
+	std::deque<std::function<void()>> tasks;
+	std::mutex mutex;
+	std::condition_variable wake;
+	bool stop = false;
+
+	void Work();
+public:
+	ThreadPool(unsigned int count);
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator = (const ThreadPool&) = delete;
+	~ThreadPool();
+
+	void Push(std::function<void()> task);
+	//body(first, last) over [begin, end) split into ranges of about grain items.
+	//The caller works too and returns when every range is done, so nesting is safe.
+	void ParallelFor(int begin, int end, int grain, const std::function<void(int, int)>& body);
+	size_t Size() const;
+};
+
+ThreadPool& Workers(); //process-wide pool, hardware_concurrency - 1 threads
\ No newline at end of file
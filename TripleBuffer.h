@@ -0,0 +1,29 @@
+#pragma once
+#include <atomic>
+
+//Hands the newest value from one writer thread to one reader thread without locks or
+//waiting. The writer fills its own slot and swaps it with the shared one; the reader
+//swaps the shared slot with its own when a fresher value is there. Values the reader
+//was too slow to see are skipped, so a value must be a state, not an event.
+template <typename T>
+class TripleBuffer {
+private:
+	static const unsigned int FRESH = 4; //set when the shared slot wasn't read yet
+	T slots[3];
+	std::atomic<unsigned int> shared{ 1 }; //index of the shared slot | FRESH
+	unsigned int write = 0; //owned by the writer
+	unsigned int read = 2; //owned by the reader
+public:
+	T& Back() { return slots[write]; } //writer: fill, then Publish
+	void Publish() {
+		write = shared.exchange(write | FRESH, std::memory_order_acq_rel) & 3;
+	}
+	bool Update() { //reader: true if Front changed
+		if (!(shared.load(std::memory_order_relaxed) & FRESH)) {
+			return false;
+		}
+		read = shared.exchange(read, std::memory_order_acq_rel) & 3;
+		return true;
+	}
+	const T& Front() const { return slots[read]; } //reader: the newest value at the last Update
+};
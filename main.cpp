@@ -1,6 +1,42 @@
 #include "Tests.h"
+#include "AssetPack.h"
+#include "Menu.h"
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
 
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--pack") == 0) { //decode all assets into assets.pack and quit
+        return AssetPack::Write("assets.pack") ? 0 : 1;
+    }
+    if (argc > 2 && strcmp(argv[1], "--export") == 0) { //render a flight into PNGs or a .y4m ("-" - stdout) and quit
+        ExportSettings settings;
+        settings.path = argv[2];
+        for (int i = 3; i + 1 < argc; i += 2) {
+            if (strcmp(argv[i], "--size") == 0) {
+                sscanf(argv[i + 1], "%ux%u", &settings.width, &settings.height);
+            }
+            else if (strcmp(argv[i], "--fps") == 0) {
+                settings.fps = std::max(atoi(argv[i + 1]), 1);
+            }
+            else if (strcmp(argv[i], "--seconds") == 0) {
+                settings.seconds = float(atof(argv[i + 1]));
+            }
+            else if (strcmp(argv[i], "--seed") == 0) {
+                settings.seed = unsigned(strtoul(argv[i + 1], nullptr, 10));
+            }
+            else if (strcmp(argv[i], "--threads") == 0) {
+                settings.threads = unsigned(atoi(argv[i + 1]));
+            }
+        }
+        return ExportFlight(settings) ? 0 : 1;
+    }
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--sim-thread") == 0) {
+            SimulationThread = true;
+        }
+    }
     //GetReady(); //for STM32
 try {
         test_menu();
@@ -0,0 +1,14 @@
+uniform float time;
+
+void main()
+{
+    //the same triangle wave as Surface::WaveOffset
+    float wave = 3.0 * (1.0 - abs(2.0 * fract(time / 2.0) - 1.0)) - 1.5;
+
+    //texCoords.x of a lake vertex is its wave direction: 1, -1 or 0 for the bottom
+    vec4 vertex = gl_Vertex;
+    vertex.y += gl_MultiTexCoord0.x * wave;
+
+    gl_Position = gl_ModelViewProjectionMatrix * vertex;
+    gl_FrontColor = gl_Color;
+}